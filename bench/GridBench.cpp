@@ -0,0 +1,33 @@
+#include "Generator.h"
+#include "Solver.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+
+int main(int argc, char **argv) {
+  const int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+  std::default_random_engine rng(argc > 2 ? std::atoi(argv[2]) : std::random_device{}());
+
+  std::unordered_set<std::string> distinct;
+  int invalid = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; ++i) {
+    const NumberGrid grid = generateSolvedGrid(rng);
+    if (!isSolved(grid)) {
+      ++invalid;
+    }
+    distinct.emplace(reinterpret_cast<const char *>(grid.data()), sizeof(grid));
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "grids:        " << count << '\n'
+            << "distinct:     " << distinct.size() << '\n'
+            << "invalid:      " << invalid << '\n'
+            << "grids/sec:    " << static_cast<long long>(count / elapsed.count()) << '\n'
+            << "us/grid:      " << elapsed.count() * 1e6 / count << std::endl;
+  return invalid == 0 ? 0 : 1;
+}
@@ -0,0 +1,44 @@
+#include "BatchSolver.h"
+#include "SolverEngine.h"
+#include "ThreadPool.h"
+
+BatchResult solveOne(const NumberGrid &puzzle, const BatchOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  BatchResult result;
+  SolverEngine &engine = options.solver.engine ? *options.solver.engine : defaultSolverEngine();
+  if (!engine.validate(puzzle)) {
+    return result;
+  }
+
+  const int limit = options.mode == BatchMode::Solve ? 1 : options.countLimit;
+  result.solutions = engine.count(puzzle, limit, options.solver, result.stats, &result.solution);
+  result.stats.elapsed = std::chrono::steady_clock::now() - start;
+  recordSolverStats(result.stats);
+
+  if (result.stats.cancelled) {
+    result.status = BatchStatus::Cancelled;
+  } else if (result.solutions == 0) {
+    result.status = BatchStatus::NoSolution;
+  } else if (options.mode == BatchMode::Solve) {
+    result.status = BatchStatus::Solved;
+  } else {
+    result.status = result.solutions == 1 ? BatchStatus::Unique : BatchStatus::Multiple;
+  }
+  return result;
+}
+
+void solveBatch(std::span<const NumberGrid> puzzles, std::span<BatchResult> results,
+                ThreadPool &pool, const BatchOptions &options) {
+  pool.parallelFor(puzzles.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      results[i] = solveOne(puzzles[i], options);
+    }
+  });
+}
+
+std::vector<BatchResult> solveBatch(std::span<const NumberGrid> puzzles, ThreadPool &pool,
+                                    const BatchOptions &options) {
+  std::vector<BatchResult> results(puzzles.size());
+  solveBatch(puzzles, results, pool, options);
+  return results;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include "Board.h"
+#include "Solver.h"
+
+#include <span>
+#include <vector>
+
+class ThreadPool;
+
+enum class BatchMode {
+  Solve,
+  Count
+};
+
+enum class BatchStatus {
+  Solved,
+  Unique,
+  Multiple,
+  NoSolution,
+  Invalid,
+  Cancelled
+};
+
+struct BatchOptions {
+  BatchMode mode = BatchMode::Solve;
+  int countLimit = 2;
+  SolverOptions solver{};
+};
+
+struct BatchResult {
+  BatchStatus status = BatchStatus::Invalid;
+  int solutions = 0;
+  SolverStats stats{};
+  NumberGrid solution{};
+};
+
+BatchResult solveOne(const NumberGrid &puzzle, const BatchOptions &options);
+void solveBatch(std::span<const NumberGrid> puzzles, std::span<BatchResult> results,
+                ThreadPool &pool, const BatchOptions &options = {});
+std::vector<BatchResult> solveBatch(std::span<const NumberGrid> puzzles, ThreadPool &pool,
+                                    const BatchOptions &options = {});
+
+#endif //!BATCH_SOLVER_H
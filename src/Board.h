@@ -0,0 +1,15 @@
+#pragma once
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <array>
+#include <cstdint>
+
+constexpr int BOARD_SIZE = 9;
+constexpr int SUBGRID_SIZE = 3;
+constexpr int BOARD_DIM = 9;
+constexpr int CELL_COUNT = BOARD_DIM * BOARD_DIM;
+
+using NumberGrid = std::array<std::array<uint8_t, BOARD_DIM>, BOARD_DIM>;
+
+#endif //!BOARD_H
@@ -0,0 +1,96 @@
+#include "CandidateGrid.h"
+
+bool CandidateGrid::load(const NumberGrid &board) {
+  cells = {};
+  rowMask = colMask = boxMask = {};
+  candidateMask.fill(ALL_DIGITS);
+  emptyPeers.fill(PEER_COUNT);
+  empties = CELL_COUNT;
+  for (int cell = 0; cell < CELL_COUNT; ++cell) {
+    emptyList[cell] = emptyIndex[cell] = static_cast<uint8_t>(cell);
+  }
+
+  bool consistent = true;
+  for (int cell = 0; cell < CELL_COUNT; ++cell) {
+    const int digit = board[rowOf(cell)][colOf(cell)];
+    if (digit == 0) {
+      continue;
+    }
+    if (digit > BOARD_DIM) {
+      return false;
+    }
+
+    if (!(freeDigits(cell) & digitBit(digit))) {
+      consistent = false;
+    }
+    place(cell, digit);
+  }
+  trailSize = 0;
+  return consistent;
+}
+
+bool CandidateGrid::propagate() {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    for (int i = empties - 1; i >= 0; --i) {
+      const int cell = emptyList[i];
+      const uint16_t mask = candidateMask[cell];
+      if (mask == 0) {
+        return false;
+      }
+
+      if (std::has_single_bit(mask)) {
+        place(cell, lowestDigit(mask));
+        changed = true;
+      }
+    }
+
+    if (changed) {
+      continue;
+    }
+
+    for (const auto &unit : UNITS) {
+      uint16_t once = 0;
+      uint16_t twice = 0;
+      uint16_t placed = 0;
+      for (int cell : unit) {
+        if (cells[cell] != 0) {
+          placed |= digitBit(cells[cell]);
+        } else {
+          twice |= once & candidateMask[cell];
+          once |= candidateMask[cell];
+        }
+      }
+
+      if ((once | placed) != ALL_DIGITS) {
+        return false;
+      }
+
+      for (uint16_t singles = once & ~twice; singles != 0; singles &= singles - 1) {
+        const uint16_t bit = singles & -singles;
+        int target = -1;
+        for (int cell : unit) {
+          if (cells[cell] == 0 && (candidateMask[cell] & bit)) {
+            target = cell;
+            break;
+          }
+        }
+
+        if (target == -1) {
+          return false;
+        }
+        place(target, lowestDigit(bit));
+        changed = true;
+      }
+    }
+  }
+  return true;
+}
+
+void CandidateGrid::store(NumberGrid &board) const {
+  for (int cell = 0; cell < CELL_COUNT; ++cell) {
+    board[rowOf(cell)][colOf(cell)] = cells[cell];
+  }
+}
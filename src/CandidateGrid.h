@@ -0,0 +1,151 @@
+#pragma once
+#ifndef CANDIDATE_GRID_H
+#define CANDIDATE_GRID_H
+
+#include "Board.h"
+
+#include <bit>
+
+constexpr int PEER_COUNT = 20;
+constexpr uint16_t ALL_DIGITS = 0x1FF;
+
+constexpr uint16_t digitBit(int digit) {
+  return static_cast<uint16_t>(1u << (digit - 1));
+}
+
+constexpr int lowestDigit(uint16_t mask) {
+  return std::countr_zero(mask) + 1;
+}
+
+constexpr int rowOf(int cell) { return cell / BOARD_DIM; }
+constexpr int colOf(int cell) { return cell % BOARD_DIM; }
+constexpr int boxOf(int cell) {
+  return (rowOf(cell) / SUBGRID_SIZE) * SUBGRID_SIZE + colOf(cell) / SUBGRID_SIZE;
+}
+
+using PeerTable = std::array<std::array<uint8_t, PEER_COUNT>, CELL_COUNT>;
+
+constexpr PeerTable makePeerTable() {
+  PeerTable table{};
+  for (int cell = 0; cell < CELL_COUNT; ++cell) {
+    int count = 0;
+    for (int other = 0; other < CELL_COUNT; ++other) {
+      if (other != cell && (rowOf(other) == rowOf(cell) || colOf(other) == colOf(cell) || boxOf(other) == boxOf(cell))) {
+        table[cell][count++] = static_cast<uint8_t>(other);
+      }
+    }
+  }
+  return table;
+}
+
+constexpr PeerTable PEERS = makePeerTable();
+
+using UnitTable = std::array<std::array<uint8_t, BOARD_DIM>, 3 * BOARD_DIM>;
+
+constexpr UnitTable makeUnitTable() {
+  UnitTable table{};
+  for (int i = 0; i < BOARD_DIM; ++i) {
+    for (int j = 0; j < BOARD_DIM; ++j) {
+      const int boxRow = (i / SUBGRID_SIZE) * SUBGRID_SIZE + j / SUBGRID_SIZE;
+      const int boxCol = (i % SUBGRID_SIZE) * SUBGRID_SIZE + j % SUBGRID_SIZE;
+      table[i][j] = static_cast<uint8_t>(i * BOARD_DIM + j);
+      table[BOARD_DIM + i][j] = static_cast<uint8_t>(j * BOARD_DIM + i);
+      table[2 * BOARD_DIM + i][j] = static_cast<uint8_t>(boxRow * BOARD_DIM + boxCol);
+    }
+  }
+  return table;
+}
+
+constexpr UnitTable UNITS = makeUnitTable();
+
+class CandidateGrid {
+  public:
+    bool load(const NumberGrid &board);
+    void store(NumberGrid &board) const;
+    bool propagate();
+
+    uint16_t candidates(int cell) const { return candidateMask[cell]; }
+
+    void place(int cell, int digit) {
+      const uint16_t bit = digitBit(digit);
+      cells[cell] = static_cast<uint8_t>(digit);
+      rowMask[rowOf(cell)] |= bit;
+      colMask[colOf(cell)] |= bit;
+      boxMask[boxOf(cell)] |= bit;
+
+      const int last = emptyList[--empties];
+      emptyList[emptyIndex[cell]] = static_cast<uint8_t>(last);
+      emptyIndex[last] = emptyIndex[cell];
+      trail[trailSize++] = static_cast<uint8_t>(cell);
+
+      for (int peer : PEERS[cell]) {
+        candidateMask[peer] &= ~bit;
+        --emptyPeers[peer];
+      }
+    }
+
+    int mark() const { return trailSize; }
+
+    void undo(int mark) {
+      while (trailSize > mark) {
+        unplace(trail[--trailSize]);
+      }
+    }
+
+    int selectCell() const {
+      int best = -1;
+      int bestCount = BOARD_DIM + 1;
+      int bestPeers = -1;
+      for (int i = 0; i < empties; ++i) {
+        const int cell = emptyList[i];
+        const int count = std::popcount(candidateMask[cell]);
+        if (count < bestCount || (count == bestCount && emptyPeers[cell] > bestPeers)) {
+          best = cell;
+          bestCount = count;
+          bestPeers = emptyPeers[cell];
+          if (count <= 1) {
+            break;
+          }
+        }
+      }
+      return best;
+    }
+
+    int value(int cell) const { return cells[cell]; }
+    int emptyCount() const { return empties; }
+  private:
+    void unplace(int cell) {
+      const uint16_t bit = digitBit(cells[cell]);
+      cells[cell] = 0;
+      rowMask[rowOf(cell)] &= ~bit;
+      colMask[colOf(cell)] &= ~bit;
+      boxMask[boxOf(cell)] &= ~bit;
+
+      emptyIndex[cell] = static_cast<uint8_t>(empties);
+      emptyList[empties++] = static_cast<uint8_t>(cell);
+
+      candidateMask[cell] = freeDigits(cell);
+      for (int peer : PEERS[cell]) {
+        candidateMask[peer] = freeDigits(peer);
+        ++emptyPeers[peer];
+      }
+    }
+
+    uint16_t freeDigits(int cell) const {
+      return ~(rowMask[rowOf(cell)] | colMask[colOf(cell)] | boxMask[boxOf(cell)]) & ALL_DIGITS;
+    }
+  private:
+    std::array<uint8_t, CELL_COUNT> cells{};
+    std::array<uint16_t, BOARD_DIM> rowMask{};
+    std::array<uint16_t, BOARD_DIM> colMask{};
+    std::array<uint16_t, BOARD_DIM> boxMask{};
+    std::array<uint16_t, CELL_COUNT> candidateMask{};
+    std::array<uint8_t, CELL_COUNT> emptyPeers{};
+    std::array<uint8_t, CELL_COUNT> emptyList{};
+    std::array<uint8_t, CELL_COUNT> emptyIndex{};
+    std::array<uint8_t, CELL_COUNT> trail{};
+    int empties = 0;
+    int trailSize = 0;
+};
+
+#endif //!CANDIDATE_GRID_H
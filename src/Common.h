@@ -2,7 +2,8 @@
 #ifndef COMMON_H
 #define COMMON_H
 
-#include <array>
+#include "Board.h"
+
 #include <cstdint>
 
 #define FWD_DECL(x) using x = struct x
@@ -11,12 +12,6 @@
 constexpr char FONT_NAME[] = "res/Roboto.ttf";
 constexpr int FONT_SIZE = 40;
 
-constexpr int BOARD_SIZE = 9;
-constexpr int SUBGRID_SIZE = 3;
-constexpr int BOARD_DIM = 9;
-
-using NumberGrid = std::array<std::array<uint8_t, BOARD_DIM>, BOARD_DIM>;
-
 FWD_DECL(SDL_Window);
 FWD_DECL(SDL_Renderer);
 FWD_DECL(SDL_Texture);
@@ -0,0 +1,201 @@
+#include "DancingLinks.h"
+
+#include <algorithm>
+
+namespace {
+  constexpr int CELLS = BOARD_DIM * BOARD_DIM;
+  constexpr int COLUMNS = 4 * CELLS;
+  constexpr int ROWS = CELLS * BOARD_DIM;
+  constexpr int ROOT = COLUMNS;
+  constexpr int NODE_COUNT = COLUMNS + 1 + ROWS * 4;
+
+  std::array<int, 4> rowColumns(int row) {
+    const int cell = row / BOARD_DIM;
+    const int digit = row % BOARD_DIM;
+    const int r = cell / BOARD_DIM;
+    const int c = cell % BOARD_DIM;
+    const int box = (r / SUBGRID_SIZE) * SUBGRID_SIZE + c / SUBGRID_SIZE;
+
+    return {
+      cell,
+      CELLS + r * BOARD_DIM + digit,
+      2 * CELLS + c * BOARD_DIM + digit,
+      3 * CELLS + box * BOARD_DIM + digit
+    };
+  }
+}
+
+DancingLinks::DancingLinks() {
+  pristine.resize(NODE_COUNT);
+  nodes.resize(NODE_COUNT);
+  pristineSizes.resize(COLUMNS);
+  sizes.resize(COLUMNS);
+  partial.resize(CELLS);
+  solution.resize(CELLS);
+  build();
+}
+
+void DancingLinks::build() {
+  for (int column = 0; column <= COLUMNS; ++column) {
+    Node &header = pristine[column];
+    header.left = column == 0 ? ROOT : column - 1;
+    header.right = column == ROOT ? 0 : column + 1;
+    header.up = header.down = header.column = column;
+  }
+
+  int next = COLUMNS + 1;
+  for (int row = 0; row < ROWS; ++row) {
+    const int first = next;
+    for (int column : rowColumns(row)) {
+      Node &node = pristine[next];
+      node.column = column;
+      node.row = row;
+      node.left = next == first ? first + 3 : next - 1;
+      node.right = next == first + 3 ? first : next + 1;
+      node.down = column;
+      node.up = pristine[column].up;
+      pristine[node.up].down = next;
+      pristine[column].up = next;
+      ++pristineSizes[column];
+      ++next;
+    }
+  }
+}
+
+bool DancingLinks::reset(const NumberGrid &board) {
+  nodes = pristine;
+  sizes = pristineSizes;
+
+  for (int cell = 0; cell < CELLS; ++cell) {
+    const int digit = board[cell / BOARD_DIM][cell % BOARD_DIM];
+    if (digit == 0) {
+      continue;
+    }
+    if (digit > BOARD_DIM) {
+      return false;
+    }
+
+    const int row = cell * BOARD_DIM + digit - 1;
+    const int first = COLUMNS + 1 + row * 4;
+    for (int node = first; node < first + 4; ++node) {
+      const int column = nodes[node].column;
+      if (nodes[nodes[column].left].right != column) {
+        return false;
+      }
+      cover(column);
+    }
+  }
+  return true;
+}
+
+void DancingLinks::cover(int column) {
+  nodes[nodes[column].right].left = nodes[column].left;
+  nodes[nodes[column].left].right = nodes[column].right;
+
+  for (int i = nodes[column].down; i != column; i = nodes[i].down) {
+    for (int j = nodes[i].right; j != i; j = nodes[j].right) {
+      nodes[nodes[j].down].up = nodes[j].up;
+      nodes[nodes[j].up].down = nodes[j].down;
+      --sizes[nodes[j].column];
+    }
+  }
+}
+
+void DancingLinks::uncover(int column) {
+  for (int i = nodes[column].up; i != column; i = nodes[i].up) {
+    for (int j = nodes[i].left; j != i; j = nodes[j].left) {
+      ++sizes[nodes[j].column];
+      nodes[nodes[j].down].up = j;
+      nodes[nodes[j].up].down = j;
+    }
+  }
+
+  nodes[nodes[column].right].left = column;
+  nodes[nodes[column].left].right = column;
+}
+
+void DancingLinks::search(int depth) {
+  if (counters.nodes % STOP_CHECK_NODES == 0 && stop.stop_requested()) {
+    counters.cancelled = true;
+    return;
+  }
+  ++counters.nodes;
+  counters.maxDepth = std::max(counters.maxDepth, depth);
+
+  if (nodes[ROOT].right == ROOT) {
+    ++counters.solutions;
+    if (found++ == 0) {
+      std::copy(partial.begin(), partial.begin() + depth, solution.begin());
+      solutionDepth = depth;
+    }
+    return;
+  }
+
+  int best = nodes[ROOT].right;
+  for (int column = nodes[best].right; column != ROOT; column = nodes[column].right) {
+    if (sizes[column] < sizes[best]) {
+      best = column;
+    }
+  }
+
+  if (sizes[best] == 0) {
+    ++counters.backtracks;
+    return;
+  }
+
+  if (sizes[best] == 1) {
+    ++counters.propagations;
+  }
+
+  cover(best);
+  for (int i = nodes[best].down; i != best && found < limit && !counters.cancelled; i = nodes[i].down) {
+    partial[depth] = nodes[i].row;
+    for (int j = nodes[i].right; j != i; j = nodes[j].right) {
+      cover(nodes[j].column);
+    }
+
+    search(depth + 1);
+
+    for (int j = nodes[i].left; j != i; j = nodes[j].left) {
+      uncover(nodes[j].column);
+    }
+  }
+  uncover(best);
+}
+
+bool DancingLinks::solve(NumberGrid &board, std::stop_token stopToken) {
+  limit = 1;
+  found = 0;
+  counters = {};
+  stop = std::move(stopToken);
+  if (!reset(board)) {
+    return false;
+  }
+
+  search(0);
+  if (found == 0) {
+    return false;
+  }
+
+  firstSolution(board);
+  return true;
+}
+
+void DancingLinks::firstSolution(NumberGrid &board) const {
+  for (int i = 0; i < solutionDepth; ++i) {
+    const int row = solution[i];
+    const int cell = row / BOARD_DIM;
+    board[cell / BOARD_DIM][cell % BOARD_DIM] = static_cast<uint8_t>(row % BOARD_DIM + 1);
+  }
+}
+
+int DancingLinks::count(const NumberGrid &board, int maxCount, std::stop_token stopToken) {
+  limit = maxCount;
+  found = 0;
+  counters = {};
+  stop = std::move(stopToken);
+  if (limit > 0 && reset(board)) {
+    search(0);
+  }
+  return found;
+}
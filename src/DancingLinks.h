@@ -0,0 +1,47 @@
+#pragma once
+#ifndef DANCING_LINKS_H
+#define DANCING_LINKS_H
+
+#include "Board.h"
+#include "Solver.h"
+
+#include <stop_token>
+#include <vector>
+
+class DancingLinks {
+  public:
+    DancingLinks();
+    bool solve(NumberGrid &board, std::stop_token stopToken = {});
+    int count(const NumberGrid &board, int limit, std::stop_token stopToken = {});
+    void firstSolution(NumberGrid &board) const;
+    const SolverStats &stats() const { return counters; }
+  private:
+    struct Node {
+      int left = 0;
+      int right = 0;
+      int up = 0;
+      int down = 0;
+      int column = 0;
+      int row = -1;
+    };
+
+    void build();
+    bool reset(const NumberGrid &board);
+    void cover(int column);
+    void uncover(int column);
+    void search(int depth);
+  private:
+    std::vector<Node> pristine;
+    std::vector<Node> nodes;
+    std::vector<int> pristineSizes;
+    std::vector<int> sizes;
+    std::vector<int> partial;
+    std::vector<int> solution;
+    SolverStats counters{};
+    std::stop_token stop;
+    int solutionDepth = 0;
+    int limit = 0;
+    int found = 0;
+};
+
+#endif //!DANCING_LINKS_H
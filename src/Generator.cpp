@@ -0,0 +1,541 @@
+#include "Generator.h"
+#include "ParallelCount.h"
+#include "Search.h"
+#include "SolverEngine.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+namespace {
+  using Order = std::array<int, BOARD_DIM>;
+
+  Order shuffledLines(std::default_random_engine &rng) {
+    std::array<int, SUBGRID_SIZE> bands;
+    std::iota(bands.begin(), bands.end(), 0);
+    std::shuffle(bands.begin(), bands.end(), rng);
+
+    Order order;
+    for (int band = 0; band < SUBGRID_SIZE; ++band) {
+      std::array<int, SUBGRID_SIZE> lines;
+      std::iota(lines.begin(), lines.end(), 0);
+      std::shuffle(lines.begin(), lines.end(), rng);
+      for (int line = 0; line < SUBGRID_SIZE; ++line) {
+        order[band * SUBGRID_SIZE + line] = bands[band] * SUBGRID_SIZE + lines[line];
+      }
+    }
+    return order;
+  }
+
+  std::vector<uint8_t> clueCells(const NumberGrid &puzzle) {
+    std::vector<uint8_t> clues;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+      if (puzzle[cell / BOARD_DIM][cell % BOARD_DIM] != 0) {
+        clues.push_back(static_cast<uint8_t>(cell));
+      }
+    }
+    return clues;
+  }
+
+  int removeSerial(GeneratedPuzzle &result, std::span<const uint8_t> cells,
+                   int maxRemovals, const GeneratorOptions &options) {
+    SolverStats callStats;
+    SolverOptions solverOptions = options.solver;
+    solverOptions.stats = &callStats;
+    const bool splitTree = options.pool && options.removal == RemovalStrategy::SplitTree;
+
+    int removedCount = 0;
+    for (int cell : cells) {
+      if (removedCount >= maxRemovals || options.solver.stop.stop_requested()) break;
+      const int r = cell / BOARD_DIM;
+      const int c = cell % BOARD_DIM;
+
+      result.puzzle[r][c] = 0;
+      const bool ambiguous = splitTree
+        ? hasAlternateSolutionParallel(result.puzzle, result.solution, r, c, *options.pool, solverOptions)
+        : hasAlternateSolution(result.puzzle, result.solution, r, c, solverOptions);
+      result.stats.add(callStats);
+
+      if (ambiguous) {
+        result.puzzle[r][c] = result.solution[r][c];
+      } else {
+        ++removedCount;
+      }
+    }
+    return removedCount;
+  }
+
+  int removeSpeculative(GeneratedPuzzle &result, const std::array<uint8_t, CELL_COUNT> &cells,
+                        int maxRemovals, const GeneratorOptions &options) {
+    const size_t window = std::max<size_t>(2, size_t(options.pool->size()) * 2);
+    std::vector<uint8_t> removable(window);
+    std::vector<SolverStats> trialStats(window);
+    SolverStats callStats;
+    SolverOptions recheckOptions = options.solver;
+    recheckOptions.stats = &callStats;
+
+    int removedCount = 0;
+    for (size_t next = 0, count = 0; next < cells.size() && removedCount < maxRemovals
+         && !options.solver.stop.stop_requested(); next += count) {
+      count = std::min(window, cells.size() - next);
+      const NumberGrid snapshot = result.puzzle;
+
+      options.pool->parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const int r = cells[next + i] / BOARD_DIM;
+          const int c = cells[next + i] % BOARD_DIM;
+          SolverOptions solverOptions = options.solver;
+          solverOptions.stats = &trialStats[i];
+
+          NumberGrid trial = snapshot;
+          trial[r][c] = 0;
+          removable[i] = !hasAlternateSolution(trial, result.solution, r, c, solverOptions);
+        }
+      });
+
+      bool stale = false;
+      for (size_t i = 0; i < count; ++i) {
+        result.stats.add(trialStats[i]);
+        if (!removable[i] || removedCount >= maxRemovals) {
+          continue;
+        }
+
+        const int r = cells[next + i] / BOARD_DIM;
+        const int c = cells[next + i] % BOARD_DIM;
+        result.puzzle[r][c] = 0;
+        if (stale) {
+          const bool ambiguous = hasAlternateSolution(result.puzzle, result.solution, r, c, recheckOptions);
+          result.stats.add(callStats);
+          if (ambiguous) {
+            result.puzzle[r][c] = result.solution[r][c];
+            continue;
+          }
+        }
+
+        ++removedCount;
+        stale = true;
+      }
+    }
+    return removedCount;
+  }
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr int MAX_ALTERNATES = 16;
+  constexpr int SWAP_TRIES = 16;
+  constexpr int MAX_STALE_MOVES = 200;
+  constexpr auto DEFAULT_MINIMAL_BUDGET = std::chrono::milliseconds(2000);
+  constexpr auto DEFAULT_SYMMETRIC_BUDGET = std::chrono::milliseconds(100);
+
+  void reduceToMinimal(GeneratedPuzzle &result, std::default_random_engine &rng, const GeneratorOptions &options) {
+    std::vector<uint8_t> clues = clueCells(result.puzzle);
+    std::shuffle(clues.begin(), clues.end(), rng);
+    result.clues -= removeSerial(result, clues, CELL_COUNT, options);
+  }
+
+  bool findSeparatingCells(const NumberGrid &trial, std::span<const int> removed, GeneratedPuzzle &result,
+                           const SolverOptions &options, std::vector<int> &separatingCells) {
+    std::bitset<CELL_COUNT> separating;
+    separating.set();
+    for (int cell : removed) {
+      separating.reset(cell);
+    }
+    int alternates = 0;
+    const auto separate = [&](const NumberGrid &alternate) {
+      ++alternates;
+      for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        if (alternate[cell / BOARD_DIM][cell % BOARD_DIM] == result.solution[cell / BOARD_DIM][cell % BOARD_DIM]) {
+          separating.reset(cell);
+        }
+      }
+    };
+
+    SolverEngine &engine = options.engine ? *options.engine : defaultSolverEngine();
+    bool exhausted = true;
+    if (engine.supportsGuidedSearch()) {
+      Search search;
+      if (!search.reset(trial, options)) {
+        return false;
+      }
+
+      NumberGrid alternate;
+      SearchStatus status;
+      while ((status = search.run()) == SearchStatus::Solved && alternates <= MAX_ALTERNATES && separating.any()) {
+        search.solution(alternate);
+        if (alternate != result.solution) {
+          separate(alternate);
+        }
+      }
+      result.stats.add(search.stats());
+      exhausted = status == SearchStatus::Exhausted;
+    } else {
+      SolverStats callStats;
+      NumberGrid board = trial;
+      NumberGrid alternate;
+      for (int cell : removed) {
+        const int r = cell / BOARD_DIM;
+        const int c = cell % BOARD_DIM;
+        for (int digit = 1; digit <= 9 && exhausted && separating.any(); ++digit) {
+          board[r][c] = static_cast<uint8_t>(digit);
+          if (digit == result.solution[r][c] || isConflicting(board, r, c)) {
+            continue;
+          }
+
+          if (engine.count(board, 1, options, callStats, &alternate) > 0) {
+            separate(alternate);
+          }
+          result.stats.add(callStats);
+          exhausted = !callStats.cancelled;
+        }
+        board[r][c] = 0;
+      }
+    }
+
+    separatingCells.clear();
+    if (!exhausted || alternates == 0) {
+      return alternates == 0 && exhausted;
+    }
+
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+      if (separating.test(cell)) {
+        separatingCells.push_back(cell);
+      }
+    }
+    return !separatingCells.empty();
+  }
+
+  bool replaceClues(GeneratedPuzzle &result, std::default_random_engine &rng, const SolverOptions &options,
+                    int removeCount, int maxTries, Clock::time_point deadline) {
+    const std::vector<uint8_t> clues = clueCells(result.puzzle);
+    const bool guided = (options.engine ? *options.engine : defaultSolverEngine()).supportsGuidedSearch();
+    std::vector<int> separating;
+    for (int attempt = 0; attempt < maxTries; ++attempt) {
+      if (Clock::now() >= deadline || options.stop.stop_requested()) {
+        return false;
+      }
+
+      NumberGrid trial = result.puzzle;
+      std::array<int, 2> removed{};
+      for (int k = 0; k < removeCount; ++k) {
+        do {
+          removed[k] = clues[rng() % clues.size()];
+        } while (k > 0 && removed[k] == removed[0]);
+        trial[removed[k] / BOARD_DIM][removed[k] % BOARD_DIM] = 0;
+      }
+
+      const std::span<const int> removedCells(removed.data(), removeCount);
+      if (!findSeparatingCells(trial, removedCells, result, options, separating)) {
+        continue;
+      }
+
+      if (separating.empty()) {
+        result.puzzle = trial;
+        result.clues -= removeCount;
+        return true;
+      }
+
+      const int added = separating[rng() % separating.size()];
+      trial[added / BOARD_DIM][added % BOARD_DIM] = result.solution[added / BOARD_DIM][added % BOARD_DIM];
+      if (!guided && countSolutions(trial, 2, options) != 1) {
+        continue;
+      }
+      result.puzzle = trial;
+      result.clues += 1 - removeCount;
+      return true;
+    }
+    return false;
+  }
+
+  template <typename Restart>
+  GeneratedPuzzle keepBestRestart(const GeneratorOptions &options, std::default_random_engine &rng,
+                                  std::chrono::milliseconds defaultBudget, int acceptClues, Restart &&restart) {
+    const auto start = Clock::now();
+    const auto budget = options.timeBudget.count() > 0 ? options.timeBudget : defaultBudget;
+    const auto deadline = budget.count() > 0 ? start + budget : Clock::time_point::max();
+
+    const size_t searchers = options.pool ? options.pool->size() : 1;
+    std::vector<std::default_random_engine::result_type> seeds(searchers);
+    for (auto &seed : seeds) {
+      seed = rng();
+    }
+
+    std::atomic<bool> reached = false;
+    std::atomic<int> restarts = 0;
+    std::mutex bestMutex;
+    GeneratedPuzzle best;
+    SolverStats total;
+
+    const auto search = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        std::default_random_engine local(seeds[i]);
+        while (!reached.load(std::memory_order_relaxed) && Clock::now() < deadline
+               && !options.solver.stop.stop_requested()) {
+          GeneratedPuzzle candidate = restart(local, deadline);
+          restarts.fetch_add(1, std::memory_order_relaxed);
+
+          std::lock_guard lock(bestMutex);
+          total.add(candidate.stats);
+          if (candidate.clues < best.clues && !options.solver.stop.stop_requested()) {
+            best = std::move(candidate);
+            reached = best.clues <= acceptClues;
+          }
+        }
+      }
+    };
+
+    if (options.pool) {
+      options.pool->parallelFor(searchers, search);
+    } else {
+      search(0, searchers);
+    }
+
+    best.attempts = restarts.load();
+    best.cancelled = options.solver.stop.stop_requested() || best.clues == CELL_COUNT;
+    best.missedTarget = !best.cancelled && best.clues > acceptClues;
+    best.stats = total;
+    if (!best.cancelled) {
+      const std::optional<uint64_t> guesses = measureGuesses(best.puzzle, options.solver.stop);
+      best.cancelled = !guesses;
+      best.guesses = guesses.value_or(0);
+    }
+    if (options.grade && !best.cancelled) {
+      best.grade = gradePuzzle(best.puzzle);
+    }
+    best.elapsed = Clock::now() - start;
+    return best;
+  }
+
+  GeneratedPuzzle generateMinimal(const GeneratorOptions &options, std::default_random_engine &rng) {
+    const int acceptClues = std::max(options.targetClues, MINIMAL_CLUE_LIMIT);
+    return keepBestRestart(options, rng, DEFAULT_MINIMAL_BUDGET, acceptClues,
+                           [&](std::default_random_engine &local, Clock::time_point deadline) {
+      GeneratedPuzzle candidate;
+      candidate.solution = generateSolvedGrid(local);
+      candidate.puzzle = candidate.solution;
+      reduceToMinimal(candidate, local, options);
+      for (int stale = 0; candidate.clues > acceptClues && stale < MAX_STALE_MOVES; ++stale) {
+        const int clues = candidate.clues;
+        if (!replaceClues(candidate, local, options.solver, 2, SWAP_TRIES, deadline)
+            && !replaceClues(candidate, local, options.solver, 1, SWAP_TRIES, deadline)) {
+          break;
+        }
+        reduceToMinimal(candidate, local, options);
+        if (candidate.clues < clues) {
+          stale = 0;
+        }
+      }
+      return candidate;
+    });
+  }
+
+  GeneratedPuzzle generateSymmetric(const GeneratorOptions &options, std::default_random_engine &rng) {
+    GeneratorOptions reachable = options;
+    if (options.symmetry == Symmetry::Rotate90) {
+      while (reachable.targetClues % 4 > 1) {
+        ++reachable.targetClues;
+      }
+    }
+
+    GeneratorOptions restartOptions = reachable;
+    restartOptions.pool = nullptr;
+    restartOptions.grade = false;
+    return keepBestRestart(reachable, rng, DEFAULT_SYMMETRIC_BUDGET, reachable.targetClues,
+                           [&](std::default_random_engine &local, Clock::time_point) {
+      return buildPuzzle(restartOptions, local);
+    });
+  }
+
+  int mirrorCell(int cell, Symmetry symmetry) {
+    const int r = rowOf(cell);
+    const int c = colOf(cell);
+    const int last = BOARD_DIM - 1;
+    switch (symmetry) {
+      case Symmetry::Rotate180:        return (last - r) * BOARD_DIM + (last - c);
+      case Symmetry::Rotate90:         return c * BOARD_DIM + (last - r);
+      case Symmetry::Diagonal:         return c * BOARD_DIM + r;
+      case Symmetry::MirrorHorizontal: return r * BOARD_DIM + (last - c);
+      case Symmetry::MirrorVertical:   return (last - r) * BOARD_DIM + c;
+      default:                         return cell;
+    }
+  }
+
+  struct Orbit {
+    std::array<uint8_t, 4> cells{};
+    uint8_t size = 0;
+  };
+
+  std::vector<Orbit> symmetryOrbits(Symmetry symmetry) {
+    std::vector<Orbit> orbits;
+    std::array<bool, CELL_COUNT> assigned{};
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+      if (assigned[cell]) {
+        continue;
+      }
+
+      Orbit orbit;
+      for (int image = cell; !assigned[image]; image = mirrorCell(image, symmetry)) {
+        assigned[image] = true;
+        orbit.cells[orbit.size++] = static_cast<uint8_t>(image);
+      }
+      orbits.push_back(orbit);
+    }
+    return orbits;
+  }
+
+  int removeSymmetric(GeneratedPuzzle &result, std::default_random_engine &rng, int maxRemovals,
+                      const GeneratorOptions &options) {
+    std::vector<Orbit> orbits = symmetryOrbits(options.symmetry);
+    std::shuffle(orbits.begin(), orbits.end(), rng);
+
+    SolverStats callStats;
+    SolverOptions solverOptions = options.solver;
+    solverOptions.stats = &callStats;
+
+    int removedCount = 0;
+    for (const Orbit &orbit : orbits) {
+      if (removedCount >= maxRemovals || options.solver.stop.stop_requested()) break;
+      if (removedCount + orbit.size > maxRemovals) continue;
+
+      const std::span<const uint8_t> cells(orbit.cells.data(), orbit.size);
+      for (int cell : cells) {
+        result.puzzle[cell / BOARD_DIM][cell % BOARD_DIM] = 0;
+      }
+
+      const bool ambiguous = hasAlternateSolution(result.puzzle, result.solution, cells, solverOptions);
+      result.stats.add(callStats);
+
+      if (ambiguous) {
+        for (int cell : cells) {
+          result.puzzle[cell / BOARD_DIM][cell % BOARD_DIM] = result.solution[cell / BOARD_DIM][cell % BOARD_DIM];
+        }
+      } else {
+        removedCount += orbit.size;
+      }
+    }
+    return removedCount;
+  }
+}
+
+NumberGrid generateSolvedGrid(std::default_random_engine &rng) {
+  NumberGrid seed{};
+  std::array<uint8_t, BOARD_DIM> digits;
+  std::iota(digits.begin(), digits.end(), 1);
+
+  for (int box = 0; box < BOARD_DIM; box += SUBGRID_SIZE) {
+    std::shuffle(digits.begin(), digits.end(), rng);
+    for (int i = 0; i < BOARD_DIM; ++i) {
+      seed[box + i / SUBGRID_SIZE][box + i % SUBGRID_SIZE] = digits[i];
+    }
+  }
+
+  Search search;
+  search.reset(seed, SolverOptions{ .propagate = false });
+  search.run();
+  search.solution(seed);
+
+  const Order rows = shuffledLines(rng);
+  const Order cols = shuffledLines(rng);
+  std::shuffle(digits.begin(), digits.end(), rng);
+  const bool transpose = rng() & 1;
+
+  NumberGrid grid;
+  for (int r = 0; r < BOARD_DIM; ++r) {
+    for (int c = 0; c < BOARD_DIM; ++c) {
+      const uint8_t value = transpose ? seed[cols[c]][rows[r]] : seed[rows[r]][cols[c]];
+      grid[r][c] = digits[value - 1];
+    }
+  }
+  return grid;
+}
+
+GeneratedPuzzle buildPuzzle(const GeneratorOptions &options, std::default_random_engine &rng) {
+  GeneratedPuzzle result;
+  result.solution = generateSolvedGrid(rng);
+  result.puzzle = result.solution;
+
+  std::array<uint8_t, CELL_COUNT> cells;
+  std::iota(cells.begin(), cells.end(), 0);
+  std::shuffle(cells.begin(), cells.end(), rng);
+
+  const int maxRemovals = CELL_COUNT - options.targetClues;
+  int removed;
+  if (options.symmetry != Symmetry::None) {
+    removed = removeSymmetric(result, rng, maxRemovals, options);
+  } else if (options.pool && options.removal == RemovalStrategy::Speculative) {
+    removed = removeSpeculative(result, cells, maxRemovals, options);
+  } else {
+    removed = removeSerial(result, cells, maxRemovals, options);
+  }
+
+  result.clues = CELL_COUNT - removed;
+  result.cancelled = options.solver.stop.stop_requested();
+  if (options.grade && !result.cancelled) {
+    result.grade = gradePuzzle(result.puzzle);
+  }
+  return result;
+}
+
+std::optional<uint64_t> measureGuesses(const NumberGrid &puzzle, std::stop_token stop) {
+  Search search;
+  if (!search.reset(puzzle, SolverOptions{ .stop = std::move(stop) })) {
+    return std::nullopt;
+  }
+
+  SearchStatus status;
+  do {
+    status = search.run();
+  } while (status == SearchStatus::Solved);
+
+  if (status == SearchStatus::Cancelled || search.nodes() == 0) {
+    return std::nullopt;
+  }
+  return search.nodes() - 1;
+}
+
+GeneratedPuzzle generatePuzzle(const GeneratorOptions &options, std::default_random_engine &rng) {
+  if (options.symmetry != Symmetry::None && options.band < 0) {
+    return generateSymmetric(options, rng);
+  }
+  if (options.removal == RemovalStrategy::Minimal) {
+    return generateMinimal(options, rng);
+  }
+
+  if (options.band < 0) {
+    const auto start = std::chrono::steady_clock::now();
+    GeneratedPuzzle result = buildPuzzle(options, rng);
+    if (!result.cancelled) {
+      const std::optional<uint64_t> guesses = measureGuesses(result.puzzle, options.solver.stop);
+      result.cancelled = !guesses;
+      result.guesses = guesses.value_or(0);
+    }
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    return result;
+  }
+
+  const HardnessBand &band = HARDNESS_BANDS[options.band];
+  GeneratorOptions candidateOptions = options;
+  candidateOptions.targetClues = band.targetClues;
+  candidateOptions.removal = RemovalStrategy::Serial;
+  candidateOptions.pool = nullptr;
+  candidateOptions.grade = false;
+
+  GeneratedPuzzle winner = keepBestRestart(options, rng, std::chrono::milliseconds::zero(), CELL_COUNT,
+                                           [&](std::default_random_engine &local, Clock::time_point) {
+    GeneratedPuzzle candidate = buildPuzzle(candidateOptions, local);
+    const std::optional<uint64_t> guesses = candidate.cancelled
+      ? std::nullopt
+      : measureGuesses(candidate.puzzle, options.solver.stop);
+    if (!guesses || *guesses < band.minGuesses || *guesses > band.maxGuesses) {
+      GeneratedPuzzle rejected;
+      rejected.stats = candidate.stats;
+      return rejected;
+    }
+    return candidate;
+  });
+  winner.band = options.band;
+  return winner;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "Board.h"
+#include "Grader.h"
+#include "Solver.h"
+
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string_view>
+
+class ThreadPool;
+
+enum class RemovalStrategy {
+  Serial,
+  SplitTree,
+  Speculative,
+  Minimal
+};
+
+enum class Symmetry {
+  None,
+  Rotate180,
+  Rotate90,
+  Diagonal,
+  MirrorHorizontal,
+  MirrorVertical
+};
+
+struct HardnessBand {
+  std::string_view name;
+  uint64_t minGuesses = 0;
+  uint64_t maxGuesses = 0;
+  int targetClues = 0;
+};
+
+constexpr std::array<HardnessBand, 4> HARDNESS_BANDS = {{
+  { "Gentle", 0, 0, 36 },
+  { "Moderate", 1, 4, 27 },
+  { "Tough", 5, 14, 24 },
+  { "Fiendish", 15, std::numeric_limits<uint64_t>::max(), 22 }
+}};
+
+// Minimal-mode searches stop at the first puzzle with this many clues or fewer, so targets
+// 17-19 all behave like 20. A search that runs out of budget first sets missedTarget.
+constexpr int MINIMAL_CLUE_LIMIT = 20;
+
+struct GeneratorOptions {
+  int targetClues = 45;
+  SolverOptions solver{};
+  RemovalStrategy removal = RemovalStrategy::Serial;
+  ThreadPool *pool = nullptr;
+  bool grade = false;
+  int band = -1;
+  std::chrono::milliseconds timeBudget{};
+  Symmetry symmetry = Symmetry::None;
+};
+
+struct GeneratedPuzzle {
+  NumberGrid puzzle{};
+  NumberGrid solution{};
+  int clues = CELL_COUNT;
+  bool cancelled = false;
+  bool missedTarget = false;
+  int band = -1;
+  int attempts = 1;
+  uint64_t guesses = 0;
+  std::chrono::nanoseconds elapsed{};
+  SolverStats stats{};
+  PuzzleGrade grade{};
+};
+
+NumberGrid generateSolvedGrid(std::default_random_engine &rng);
+GeneratedPuzzle buildPuzzle(const GeneratorOptions &options, std::default_random_engine &rng);
+GeneratedPuzzle generatePuzzle(const GeneratorOptions &options, std::default_random_engine &rng);
+std::optional<uint64_t> measureGuesses(const NumberGrid &puzzle, std::stop_token stop = {});
+
+#endif //!GENERATOR_H
@@ -0,0 +1,382 @@
+#include "Grader.h"
+#include "CandidateGrid.h"
+
+#include <algorithm>
+
+namespace {
+  constexpr std::array<int, TECHNIQUE_COUNT> TECHNIQUE_WEIGHTS = { 1, 1, 10, 20, 25, 30, 35, 40, 60, 80, 200 };
+  constexpr std::array<std::string_view, TECHNIQUE_COUNT> TECHNIQUE_NAMES = {
+    "Hidden Single", "Naked Single", "Locked Candidates", "Naked Pair", "Hidden Pair",
+    "Naked Triple", "Hidden Triple", "X-Wing", "Swordfish", "XY-Chain", "Backtracking"
+  };
+
+  constexpr int BOX_UNIT = 2 * BOARD_DIM;
+
+  bool sharesUnit(int a, int b) {
+    return rowOf(a) == rowOf(b) || colOf(a) == colOf(b) || boxOf(a) == boxOf(b);
+  }
+
+  template <typename Visit>
+  bool anySubset(uint16_t eligible, int size, Visit &&visit) {
+    for (uint16_t subset = eligible; subset != 0; subset = (subset - 1) & eligible) {
+      if (std::popcount(subset) == size && visit(subset)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  class HumanSolver {
+    public:
+      bool load(const NumberGrid &board) {
+        candidates.fill(ALL_DIGITS);
+        cells.fill(0);
+        empties = CELL_COUNT;
+        for (int cell = 0; cell < CELL_COUNT; ++cell) {
+          const int digit = board[rowOf(cell)][colOf(cell)];
+          if (digit == 0) {
+            continue;
+          }
+          if (!(candidates[cell] & digitBit(digit))) {
+            return false;
+          }
+          place(cell, digit);
+        }
+        return true;
+      }
+
+      PuzzleGrade grade() {
+        while (empties > 0 && !broken) {
+          if (hiddenSingles() || nakedSingles() || lockedCandidates()
+              || nakedSubsets(2) || hiddenSubsets(2) || nakedSubsets(3) || hiddenSubsets(3)
+              || fish(2) || fish(3) || xyChains()) {
+            continue;
+          }
+
+          use(Technique::Backtracking);
+          break;
+        }
+
+        result.solved = empties == 0 && !broken;
+        return result;
+      }
+    private:
+      void use(Technique technique) {
+        ++result.uses[static_cast<int>(technique)];
+        result.score += techniqueWeight(technique);
+        result.hardest = std::max(result.hardest, technique);
+      }
+
+      void place(int cell, int digit) {
+        const uint16_t bit = digitBit(digit);
+        cells[cell] = static_cast<uint8_t>(digit);
+        candidates[cell] = 0;
+        for (int peer : PEERS[cell]) {
+          candidates[peer] &= ~bit;
+        }
+        --empties;
+      }
+
+      bool eliminate(int cell, uint16_t digits) {
+        if (cells[cell] != 0 || !(candidates[cell] & digits)) {
+          return false;
+        }
+        candidates[cell] &= ~digits;
+        broken |= candidates[cell] == 0;
+        return true;
+      }
+
+      bool hiddenSingles() {
+        bool progress = false;
+        for (const auto &unit : UNITS) {
+          uint16_t once = 0, twice = 0, placed = 0;
+          for (int cell : unit) {
+            if (cells[cell] != 0) {
+              placed |= digitBit(cells[cell]);
+            } else {
+              twice |= once & candidates[cell];
+              once |= candidates[cell];
+            }
+          }
+
+          if ((once | placed) != ALL_DIGITS) {
+            broken = true;
+            return true;
+          }
+
+          for (uint16_t singles = once & ~twice; singles != 0; singles &= singles - 1) {
+            const int digit = lowestDigit(singles);
+            for (int cell : unit) {
+              if (candidates[cell] & digitBit(digit)) {
+                place(cell, digit);
+                use(Technique::HiddenSingle);
+                progress = true;
+                break;
+              }
+            }
+          }
+        }
+        return progress;
+      }
+
+      bool nakedSingles() {
+        bool progress = false;
+        for (int cell = 0; cell < CELL_COUNT; ++cell) {
+          if (cells[cell] != 0) {
+            continue;
+          }
+          if (candidates[cell] == 0) {
+            broken = true;
+            return true;
+          }
+          if (std::popcount(candidates[cell]) == 1) {
+            place(cell, lowestDigit(candidates[cell]));
+            use(Technique::NakedSingle);
+            progress = true;
+          }
+        }
+        return progress;
+      }
+
+      bool lockedCandidates() {
+        for (int unit = 0; unit < static_cast<int>(UNITS.size()); ++unit) {
+          for (int digit = 1; digit <= BOARD_DIM; ++digit) {
+            const uint16_t bit = digitBit(digit);
+            uint16_t rows = 0, cols = 0, boxes = 0;
+            for (int cell : UNITS[unit]) {
+              if (candidates[cell] & bit) {
+                rows |= 1 << rowOf(cell);
+                cols |= 1 << colOf(cell);
+                boxes |= 1 << boxOf(cell);
+              }
+            }
+            if (rows == 0) {
+              continue;
+            }
+
+            bool progress = false;
+            if (unit >= BOX_UNIT) {
+              if (std::popcount(rows) == 1) {
+                for (int cell : UNITS[std::countr_zero(rows)]) {
+                  progress |= boxOf(cell) != unit - BOX_UNIT && eliminate(cell, bit);
+                }
+              }
+              if (std::popcount(cols) == 1) {
+                for (int cell : UNITS[BOARD_DIM + std::countr_zero(cols)]) {
+                  progress |= boxOf(cell) != unit - BOX_UNIT && eliminate(cell, bit);
+                }
+              }
+            } else if (std::popcount(boxes) == 1) {
+              for (int cell : UNITS[BOX_UNIT + std::countr_zero(boxes)]) {
+                const bool inLine = unit < BOARD_DIM ? rowOf(cell) == unit : colOf(cell) == unit - BOARD_DIM;
+                progress |= !inLine && eliminate(cell, bit);
+              }
+            }
+
+            if (progress) {
+              use(Technique::LockedCandidates);
+              return true;
+            }
+          }
+        }
+        return false;
+      }
+
+      bool nakedSubsets(int size) {
+        for (const auto &unit : UNITS) {
+          uint16_t eligible = 0;
+          for (int i = 0; i < BOARD_DIM; ++i) {
+            const int count = std::popcount(candidates[unit[i]]);
+            if (count >= 2 && count <= size) {
+              eligible |= 1 << i;
+            }
+          }
+
+          const bool found = anySubset(eligible, size, [&](uint16_t subset) {
+            uint16_t digits = 0;
+            for (uint16_t rest = subset; rest != 0; rest &= rest - 1) {
+              digits |= candidates[unit[std::countr_zero(rest)]];
+            }
+            if (std::popcount(digits) != size) {
+              return false;
+            }
+
+            bool progress = false;
+            for (int i = 0; i < BOARD_DIM; ++i) {
+              progress |= !(subset & (1 << i)) && eliminate(unit[i], digits);
+            }
+            return progress;
+          });
+
+          if (found) {
+            use(size == 2 ? Technique::NakedPair : Technique::NakedTriple);
+            return true;
+          }
+        }
+        return false;
+      }
+
+      bool hiddenSubsets(int size) {
+        for (const auto &unit : UNITS) {
+          std::array<uint16_t, BOARD_DIM> positions{};
+          uint16_t eligible = 0;
+          for (int digit = 1; digit <= BOARD_DIM; ++digit) {
+            for (int i = 0; i < BOARD_DIM; ++i) {
+              if (candidates[unit[i]] & digitBit(digit)) {
+                positions[digit - 1] |= 1 << i;
+              }
+            }
+            const int count = std::popcount(positions[digit - 1]);
+            if (count >= 2 && count <= size) {
+              eligible |= digitBit(digit);
+            }
+          }
+
+          const bool found = anySubset(eligible, size, [&](uint16_t digits) {
+            uint16_t cover = 0;
+            for (uint16_t rest = digits; rest != 0; rest &= rest - 1) {
+              cover |= positions[std::countr_zero(rest)];
+            }
+            if (std::popcount(cover) != size) {
+              return false;
+            }
+
+            bool progress = false;
+            for (uint16_t rest = cover; rest != 0; rest &= rest - 1) {
+              progress |= eliminate(unit[std::countr_zero(rest)], ALL_DIGITS & ~digits);
+            }
+            return progress;
+          });
+
+          if (found) {
+            use(size == 2 ? Technique::HiddenPair : Technique::HiddenTriple);
+            return true;
+          }
+        }
+        return false;
+      }
+
+      bool fish(int size) {
+        for (int digit = 1; digit <= BOARD_DIM; ++digit) {
+          const uint16_t bit = digitBit(digit);
+          for (int byColumn = 0; byColumn < 2; ++byColumn) {
+            std::array<uint16_t, BOARD_DIM> positions{};
+            uint16_t eligible = 0;
+            for (int line = 0; line < BOARD_DIM; ++line) {
+              for (int cross = 0; cross < BOARD_DIM; ++cross) {
+                const int cell = byColumn ? cross * BOARD_DIM + line : line * BOARD_DIM + cross;
+                if (candidates[cell] & bit) {
+                  positions[line] |= 1 << cross;
+                }
+              }
+              const int count = std::popcount(positions[line]);
+              if (count >= 2 && count <= size) {
+                eligible |= 1 << line;
+              }
+            }
+
+            const bool found = anySubset(eligible, size, [&](uint16_t lines) {
+              uint16_t cover = 0;
+              for (uint16_t rest = lines; rest != 0; rest &= rest - 1) {
+                cover |= positions[std::countr_zero(rest)];
+              }
+              if (std::popcount(cover) != size) {
+                return false;
+              }
+
+              bool progress = false;
+              for (int line = 0; line < BOARD_DIM; ++line) {
+                if (lines & (1 << line)) {
+                  continue;
+                }
+                for (uint16_t rest = cover; rest != 0; rest &= rest - 1) {
+                  const int cross = std::countr_zero(rest);
+                  progress |= eliminate(byColumn ? cross * BOARD_DIM + line : line * BOARD_DIM + cross, bit);
+                }
+              }
+              return progress;
+            });
+
+            if (found) {
+              use(size == 2 ? Technique::XWing : Technique::Swordfish);
+              return true;
+            }
+          }
+        }
+        return false;
+      }
+
+      bool xyChains() {
+        std::array<bool, CELL_COUNT * BOARD_DIM> seen;
+        for (int start = 0; start < CELL_COUNT; ++start) {
+          if (std::popcount(candidates[start]) != 2) {
+            continue;
+          }
+
+          for (uint16_t targets = candidates[start]; targets != 0; targets &= targets - 1) {
+            const uint16_t target = targets & -targets;
+            const int first = start * BOARD_DIM + lowestDigit(candidates[start] & ~target) - 1;
+            seen.fill(false);
+            seen[first] = true;
+            chainQueue[0] = static_cast<uint16_t>(first);
+
+            for (int head = 0, tail = 1; head < tail; ++head) {
+              const int cell = chainQueue[head] / BOARD_DIM;
+              const uint16_t on = digitBit(chainQueue[head] % BOARD_DIM + 1);
+
+              for (int peer : PEERS[cell]) {
+                if (std::popcount(candidates[peer]) != 2 || !(candidates[peer] & on)) {
+                  continue;
+                }
+
+                const uint16_t next = candidates[peer] & ~on;
+                const int state = peer * BOARD_DIM + lowestDigit(next) - 1;
+                if (seen[state]) {
+                  continue;
+                }
+                seen[state] = true;
+
+                if (next == target && peer != start && eliminateSeenByBoth(start, peer, target)) {
+                  use(Technique::XYChain);
+                  return true;
+                }
+                chainQueue[tail++] = static_cast<uint16_t>(state);
+              }
+            }
+          }
+        }
+        return false;
+      }
+
+      bool eliminateSeenByBoth(int a, int b, uint16_t digit) {
+        bool progress = false;
+        for (int cell : PEERS[a]) {
+          progress |= cell != b && sharesUnit(cell, b) && eliminate(cell, digit);
+        }
+        return progress;
+      }
+    private:
+      std::array<uint16_t, CELL_COUNT> candidates{};
+      std::array<uint8_t, CELL_COUNT> cells{};
+      std::array<uint16_t, CELL_COUNT * BOARD_DIM> chainQueue{};
+      int empties = 0;
+      bool broken = false;
+      PuzzleGrade result{};
+  };
+}
+
+PuzzleGrade gradePuzzle(const NumberGrid &puzzle) {
+  HumanSolver solver;
+  if (!solver.load(puzzle)) {
+    return {};
+  }
+  return solver.grade();
+}
+
+std::string_view techniqueName(Technique technique) {
+  return TECHNIQUE_NAMES[static_cast<int>(technique)];
+}
+
+int techniqueWeight(Technique technique) {
+  return TECHNIQUE_WEIGHTS[static_cast<int>(technique)];
+}
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef GRADER_H
+#define GRADER_H
+
+#include "Board.h"
+
+#include <string_view>
+
+enum class Technique {
+  HiddenSingle,
+  NakedSingle,
+  LockedCandidates,
+  NakedPair,
+  HiddenPair,
+  NakedTriple,
+  HiddenTriple,
+  XWing,
+  Swordfish,
+  XYChain,
+  Backtracking
+};
+
+constexpr int TECHNIQUE_COUNT = static_cast<int>(Technique::Backtracking) + 1;
+
+struct PuzzleGrade {
+  bool solved = false;
+  Technique hardest = Technique::HiddenSingle;
+  int score = 0;
+  std::array<int, TECHNIQUE_COUNT> uses{};
+};
+
+PuzzleGrade gradePuzzle(const NumberGrid &puzzle);
+std::string_view techniqueName(Technique technique);
+int techniqueWeight(Technique technique);
+
+#endif //!GRADER_H
@@ -0,0 +1,152 @@
+#include "ParallelCount.h"
+#include "Search.h"
+#include "SolverEngine.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace {
+  constexpr int MAX_SPLIT_DEPTH = 4;
+  constexpr int TASKS_PER_WORKER = 4;
+  constexpr uint64_t NODES_PER_SLICE = 512;
+}
+
+int countSolutionsParallel(const NumberGrid &board, int limit, ThreadPool &pool,
+                           const SolverOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  SolverStats stats;
+  std::mutex statsMutex;
+  auto finish = [&](int count) {
+    stats.solutions = count;
+    stats.elapsed = std::chrono::steady_clock::now() - start;
+    recordSolverStats(stats);
+    if (options.stats) {
+      *options.stats = stats;
+    }
+    return count;
+  };
+
+  if (limit <= 0) {
+    return finish(0);
+  }
+
+  std::atomic<int> found = 0;
+  std::vector<NumberGrid> frontier = { board };
+  std::vector<NumberGrid> next;
+  const size_t targetTasks = size_t(pool.size()) * TASKS_PER_WORKER;
+
+  for (int level = 0; level < MAX_SPLIT_DEPTH && frontier.size() < targetTasks; ++level) {
+    next.clear();
+    for (const NumberGrid &node : frontier) {
+      ++stats.nodes;
+      stats.maxDepth = level;
+
+      CandidateGrid grid;
+      if (!grid.load(node)) {
+        ++stats.backtracks;
+        continue;
+      }
+
+      if (options.propagate) {
+        const bool consistent = grid.propagate();
+        stats.propagations += grid.mark();
+        if (!consistent) {
+          ++stats.backtracks;
+          continue;
+        }
+      }
+
+      if (grid.emptyCount() == 0) {
+        if (++found >= limit) {
+          return finish(limit);
+        }
+        continue;
+      }
+
+      const int cell = grid.selectCell();
+      NumberGrid expanded;
+      grid.store(expanded);
+      for (uint16_t mask = grid.candidates(cell); mask != 0; mask &= mask - 1) {
+        expanded[rowOf(cell)][colOf(cell)] = static_cast<uint8_t>(lowestDigit(mask));
+        next.push_back(expanded);
+      }
+    }
+    frontier.swap(next);
+  }
+
+  const int splitDepth = stats.maxDepth + 1;
+  SolverEngine &engine = options.engine ? *options.engine : defaultSolverEngine();
+  pool.parallelFor(frontier.size(), [&](size_t begin, size_t end) {
+    SolverStats taskStats;
+    Search search;
+    for (size_t i = begin; i < end && found.load(std::memory_order_relaxed) < limit; ++i) {
+      if (!engine.supportsGuidedSearch()) {
+        SolverStats engineStats;
+        const int remaining = std::max(1, limit - found.load(std::memory_order_relaxed));
+        found.fetch_add(engine.count(frontier[i], remaining, options, engineStats), std::memory_order_relaxed);
+        taskStats.add(engineStats);
+        continue;
+      }
+
+      if (!search.reset(frontier[i], options)) {
+        continue;
+      }
+
+      while (found.load(std::memory_order_relaxed) < limit) {
+        const SearchStatus status = search.run(NODES_PER_SLICE);
+        if (status == SearchStatus::Solved) {
+          found.fetch_add(1, std::memory_order_relaxed);
+        } else if (status != SearchStatus::Suspended) {
+          break;
+        }
+      }
+
+      taskStats.add(search.stats());
+    }
+
+    taskStats.maxDepth += splitDepth;
+    std::lock_guard lock(statsMutex);
+    stats.nodes += taskStats.nodes;
+    stats.backtracks += taskStats.backtracks;
+    stats.propagations += taskStats.propagations;
+    stats.maxDepth = std::max(stats.maxDepth, taskStats.maxDepth);
+    stats.cancelled = stats.cancelled || taskStats.cancelled;
+  });
+
+  return finish(std::min(found.load(), limit));
+}
+
+bool hasAlternateSolutionParallel(const NumberGrid &puzzle, const NumberGrid &solution, int row, int col,
+                                  ThreadPool &pool, const SolverOptions &options) {
+  if (isForced(puzzle, row, col, solution[row][col])) {
+    if (options.stats) {
+      *options.stats = {};
+    }
+    return false;
+  }
+
+  SolverStats total;
+  SolverStats callStats;
+  SolverOptions callOptions = options;
+  callOptions.stats = &callStats;
+
+  NumberGrid board = puzzle;
+  bool found = false;
+  for (int digit = 1; digit <= 9 && !found; ++digit) {
+    board[row][col] = static_cast<uint8_t>(digit);
+    if (digit == solution[row][col] || isConflicting(board, row, col)) {
+      continue;
+    }
+
+    found = countSolutionsParallel(board, 1, pool, callOptions) > 0 || callStats.cancelled;
+    total.add(callStats);
+  }
+
+  if (options.stats) {
+    *options.stats = total;
+  }
+  return found;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#ifndef PARALLEL_COUNT_H
+#define PARALLEL_COUNT_H
+
+#include "Board.h"
+#include "Solver.h"
+
+class ThreadPool;
+
+int countSolutionsParallel(const NumberGrid &board, int limit, ThreadPool &pool,
+                           const SolverOptions &options = {});
+bool hasAlternateSolutionParallel(const NumberGrid &puzzle, const NumberGrid &solution, int row, int col,
+                                  ThreadPool &pool, const SolverOptions &options = {});
+
+#endif //!PARALLEL_COUNT_H
@@ -0,0 +1,229 @@
+#include "PuzzleBank.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+PuzzleRecord encodePuzzle(const GeneratedPuzzle &puzzle) {
+  PuzzleRecord record;
+  for (int cell = 0; cell < CELL_COUNT; ++cell) {
+    const int r = cell / BOARD_DIM;
+    const int c = cell % BOARD_DIM;
+    record.solution[cell / 2] |= static_cast<uint8_t>(puzzle.solution[r][c] << (cell % 2 * 4));
+    if (puzzle.puzzle[r][c] != 0) {
+      record.clues[cell / 8] |= static_cast<uint8_t>(1 << (cell % 8));
+    }
+  }
+  record.guesses = static_cast<uint32_t>(std::min<uint64_t>(puzzle.guesses, std::numeric_limits<uint32_t>::max()));
+  record.score = static_cast<uint32_t>(puzzle.grade.score);
+  record.hardest = static_cast<uint8_t>(puzzle.grade.hardest);
+  record.solved = puzzle.grade.solved;
+  return record;
+}
+
+bool decodePuzzle(const PuzzleRecord &record, GeneratedPuzzle &puzzle) {
+  if (record.hardest >= TECHNIQUE_COUNT || record.solved > 1) {
+    return false;
+  }
+
+  puzzle.clues = 0;
+  for (int cell = 0; cell < CELL_COUNT; ++cell) {
+    const int r = cell / BOARD_DIM;
+    const int c = cell % BOARD_DIM;
+    const uint8_t value = (record.solution[cell / 2] >> (cell % 2 * 4)) & 0xF;
+    if (value < 1 || value > BOARD_DIM) {
+      return false;
+    }
+
+    const bool clue = (record.clues[cell / 8] >> (cell % 8)) & 1;
+    puzzle.solution[r][c] = value;
+    puzzle.puzzle[r][c] = clue ? value : 0;
+    puzzle.clues += clue;
+  }
+
+  puzzle.guesses = record.guesses;
+  puzzle.grade.solved = record.solved != 0;
+  puzzle.grade.hardest = static_cast<Technique>(record.hardest);
+  puzzle.grade.score = static_cast<int>(std::min<uint32_t>(record.score, std::numeric_limits<int>::max()));
+  return true;
+}
+
+bool writePuzzleBank(const std::string &path, const std::vector<PuzzleBankLevel> &levels) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  BankHeader header;
+  header.levelCount = static_cast<uint32_t>(levels.size());
+  header.recordOffset = sizeof(BankHeader) + levels.size() * sizeof(BankLevel);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  uint64_t firstRecord = 0;
+  for (const PuzzleBankLevel &level : levels) {
+    BankLevel entry;
+    entry.targetClues = level.targetClues;
+    entry.band = level.band;
+    entry.firstRecord = firstRecord;
+    entry.recordCount = level.records.size();
+    file.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    firstRecord += level.records.size();
+  }
+
+  for (const PuzzleBankLevel &level : levels) {
+    file.write(reinterpret_cast<const char *>(level.records.data()), level.records.size() * sizeof(PuzzleRecord));
+  }
+  return file.good();
+}
+
+PuzzleBank::PuzzleBank()
+  : rng(std::random_device{}()) {
+}
+
+PuzzleBank::~PuzzleBank() {
+  close();
+}
+
+bool PuzzleBank::open(const std::string &path) {
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_RANDOM_ACCESS, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER fileSize;
+  HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+    ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+    : nullptr;
+  const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!view) {
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  fileHandle = file;
+  mappingHandle = mapping;
+  data = static_cast<const uint8_t *>(view);
+  size = static_cast<size_t>(fileSize.QuadPart);
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+  void *view = fstat(fd, &info) == 0 && info.st_size > 0
+    ? mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0)
+    : MAP_FAILED;
+  ::close(fd);
+  if (view == MAP_FAILED) {
+    return false;
+  }
+
+  madvise(view, static_cast<size_t>(info.st_size), MADV_RANDOM);
+  data = static_cast<const uint8_t *>(view);
+  size = static_cast<size_t>(info.st_size);
+#endif
+
+  header = reinterpret_cast<const BankHeader *>(data);
+  uint64_t total = 0;
+  bool valid = size >= sizeof(BankHeader) && header->magic == BANK_MAGIC && header->version == BANK_VERSION
+    && header->recordOffset == sizeof(BankHeader) + uint64_t(header->levelCount) * sizeof(BankLevel)
+    && header->recordOffset <= size;
+  if (valid) {
+    levels = reinterpret_cast<const BankLevel *>(data + sizeof(BankHeader));
+    records = reinterpret_cast<const PuzzleRecord *>(data + header->recordOffset);
+  }
+  const uint64_t available = valid ? (size - header->recordOffset) / sizeof(PuzzleRecord) : 0;
+  for (uint32_t i = 0; valid && i < header->levelCount; ++i) {
+    valid = levels[i].firstRecord == total && levels[i].recordCount <= available - total;
+    total += levels[i].recordCount;
+  }
+  if (!valid) {
+    close();
+    return false;
+  }
+
+  cursors.assign(header->levelCount, {});
+  for (uint32_t i = 0; i < header->levelCount; ++i) {
+    const uint64_t count = levels[i].recordCount;
+    Cursor &cursor = cursors[i];
+    if (count < 2) {
+      continue;
+    }
+
+    cursor.start = std::uniform_int_distribution<uint64_t>(0, count - 1)(rng);
+    do {
+      cursor.stride = std::uniform_int_distribution<uint64_t>(1, count - 1)(rng);
+    } while (std::gcd(cursor.stride, count) != 1);
+  }
+  return true;
+}
+
+void PuzzleBank::close() {
+  if (data) {
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    mappingHandle = fileHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t *>(data), size);
+#endif
+  }
+
+  data = nullptr;
+  size = 0;
+  header = nullptr;
+  levels = nullptr;
+  records = nullptr;
+  cursors.clear();
+}
+
+const BankLevel *PuzzleBank::findLevel(int targetClues, int band, size_t &index) const {
+  for (index = 0; isOpen() && index < header->levelCount; ++index) {
+    const BankLevel &level = levels[index];
+    if (level.band == band && (band >= 0 || level.targetClues == targetClues)) {
+      return &level;
+    }
+  }
+  return nullptr;
+}
+
+bool PuzzleBank::draw(int targetClues, int band, GeneratedPuzzle &puzzle) {
+  size_t index;
+  const BankLevel *level = findLevel(targetClues, band, index);
+  if (!level || cursors[index].drawn >= level->recordCount) {
+    return false;
+  }
+
+  Cursor &cursor = cursors[index];
+  const uint64_t offset = (cursor.start + cursor.drawn++ * cursor.stride) % level->recordCount;
+  const PuzzleRecord &record = records[level->firstRecord + offset];
+
+  puzzle = {};
+  puzzle.band = band;
+  puzzle.attempts = 0;
+  return decodePuzzle(record, puzzle);
+}
+
+uint64_t PuzzleBank::remaining(int targetClues, int band) const {
+  size_t index;
+  const BankLevel *level = findLevel(targetClues, band, index);
+  return level ? level->recordCount - cursors[index].drawn : 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef PUZZLE_BANK_H
+#define PUZZLE_BANK_H
+
+#include "Board.h"
+#include "Generator.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr std::array<char, 8> BANK_MAGIC = { 'S', 'U', 'D', 'O', 'K', 'U', 'B', 'K' };
+constexpr uint32_t BANK_VERSION = 2;
+constexpr int PACKED_GRID_BYTES = (CELL_COUNT + 1) / 2;
+constexpr int CLUE_MASK_BYTES = (CELL_COUNT + 7) / 8;
+
+struct BankHeader {
+  std::array<char, 8> magic = BANK_MAGIC;
+  uint32_t version = BANK_VERSION;
+  uint32_t levelCount = 0;
+  uint64_t recordOffset = 0;
+};
+
+struct BankLevel {
+  int32_t targetClues = 0;
+  int32_t band = -1;
+  uint64_t firstRecord = 0;
+  uint64_t recordCount = 0;
+};
+
+struct PuzzleRecord {
+  std::array<uint8_t, PACKED_GRID_BYTES> solution{};
+  std::array<uint8_t, CLUE_MASK_BYTES> clues{};
+  uint32_t guesses = 0;
+  uint32_t score = 0;
+  uint8_t hardest = 0;
+  uint8_t solved = 0;
+  std::array<uint8_t, 2> reserved{};
+};
+
+static_assert(sizeof(BankHeader) == 24 && sizeof(BankLevel) == 24 && sizeof(PuzzleRecord) == 64,
+              "bank structures must match the on-disk layout");
+
+struct PuzzleBankLevel {
+  int targetClues = 0;
+  int band = -1;
+  std::vector<PuzzleRecord> records;
+};
+
+PuzzleRecord encodePuzzle(const GeneratedPuzzle &puzzle);
+bool decodePuzzle(const PuzzleRecord &record, GeneratedPuzzle &puzzle);
+bool writePuzzleBank(const std::string &path, const std::vector<PuzzleBankLevel> &levels);
+
+class PuzzleBank {
+  public:
+    PuzzleBank();
+    ~PuzzleBank();
+    PuzzleBank(const PuzzleBank &) = delete;
+    PuzzleBank &operator=(const PuzzleBank &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    bool draw(int targetClues, int band, GeneratedPuzzle &puzzle);
+    uint64_t remaining(int targetClues, int band) const;
+  private:
+    struct Cursor {
+      uint64_t start = 0;
+      uint64_t stride = 1;
+      uint64_t drawn = 0;
+    };
+
+    const BankLevel *findLevel(int targetClues, int band, size_t &index) const;
+  private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    const BankHeader *header = nullptr;
+    const BankLevel *levels = nullptr;
+    const PuzzleRecord *records = nullptr;
+    std::vector<Cursor> cursors;
+    std::default_random_engine rng;
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#endif
+};
+
+#endif //!PUZZLE_BANK_H
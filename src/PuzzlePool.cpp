@@ -0,0 +1,113 @@
+#include "PuzzlePool.h"
+#include "ThreadPool.h"
+
+PuzzlePool::PuzzlePool(ThreadPool &workers, const std::vector<GeneratorOptions> &kinds, size_t depth)
+  : workers(workers), depth(depth) {
+  for (const GeneratorOptions &kind : kinds) {
+    slots.push_back({ kind, {} });
+  }
+
+  std::lock_guard lock(mutex);
+  scheduleRefill();
+}
+
+PuzzlePool::~PuzzlePool() {
+  std::unique_lock lock(mutex);
+  stopping = true;
+  refillStop.request_stop();
+  idle.wait(lock, [this] { return !refilling; });
+}
+
+bool PuzzlePool::tryPop(int targetClues, int band, GeneratedPuzzle &puzzle) {
+  std::lock_guard lock(mutex);
+  Slot *slot = findSlot(targetClues, band);
+  if (!slot || slot->ready.empty()) {
+    return false;
+  }
+
+  puzzle = slot->ready.front();
+  slot->ready.pop_front();
+  scheduleRefill();
+  return true;
+}
+
+size_t PuzzlePool::readyCount(int targetClues, int band) {
+  std::lock_guard lock(mutex);
+  Slot *slot = findSlot(targetClues, band);
+  return slot ? slot->ready.size() : 0;
+}
+
+void PuzzlePool::interruptRefill() {
+  std::lock_guard lock(mutex);
+  stopRefill();
+}
+
+void PuzzlePool::setSolverOptions(const SolverOptions &solver) {
+  std::lock_guard lock(mutex);
+  ++optionsVersion;
+  for (Slot &slot : slots) {
+    slot.options.solver = solver;
+    slot.ready.clear();
+  }
+  stopRefill();
+  scheduleRefill();
+}
+
+PuzzlePool::Slot *PuzzlePool::findSlot(int targetClues, int band) {
+  for (Slot &slot : slots) {
+    if (slot.options.band == band && (band >= 0 || slot.options.targetClues == targetClues)) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+PuzzlePool::Slot *PuzzlePool::neediestSlot() {
+  Slot *neediest = nullptr;
+  for (Slot &slot : slots) {
+    if (slot.ready.size() < depth && (!neediest || slot.ready.size() < neediest->ready.size())) {
+      neediest = &slot;
+    }
+  }
+  return neediest;
+}
+
+void PuzzlePool::scheduleRefill() {
+  if (refilling || stopping || !neediestSlot()) {
+    return;
+  }
+
+  refilling = true;
+  workers.submit([this] { refillOne(); }, TaskPriority::Low);
+}
+
+void PuzzlePool::stopRefill() {
+  if (refilling) {
+    refillStop.request_stop();
+    refillStop = {};
+  }
+}
+
+void PuzzlePool::refillOne() {
+  thread_local std::default_random_engine rng(std::random_device{}());
+
+  std::unique_lock lock(mutex);
+  Slot *slot = stopping ? nullptr : neediestSlot();
+  if (slot) {
+    GeneratorOptions options = slot->options;
+    options.solver.stop = refillStop.get_token();
+    const uint64_t version = optionsVersion;
+    lock.unlock();
+    GeneratedPuzzle puzzle = generatePuzzle(options, rng);
+    lock.lock();
+    if (!puzzle.cancelled && !puzzle.missedTarget && version == optionsVersion) {
+      slot->ready.push_back(std::move(puzzle));
+    }
+  }
+
+  refilling = false;
+  scheduleRefill();
+  if (!refilling) {
+    idle.notify_all();
+  }
+}
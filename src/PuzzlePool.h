@@ -0,0 +1,50 @@
+#pragma once
+#ifndef PUZZLE_POOL_H
+#define PUZZLE_POOL_H
+
+#include "Generator.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <vector>
+
+class ThreadPool;
+
+class PuzzlePool {
+  public:
+    PuzzlePool(ThreadPool &workers, const std::vector<GeneratorOptions> &kinds, size_t depth);
+    ~PuzzlePool();
+    PuzzlePool(const PuzzlePool &) = delete;
+    PuzzlePool &operator=(const PuzzlePool &) = delete;
+
+    bool tryPop(int targetClues, int band, GeneratedPuzzle &puzzle);
+    size_t readyCount(int targetClues, int band);
+    void interruptRefill();
+    void setSolverOptions(const SolverOptions &solver);
+  private:
+    struct Slot {
+      GeneratorOptions options;
+      std::deque<GeneratedPuzzle> ready;
+    };
+
+    Slot *findSlot(int targetClues, int band);
+    Slot *neediestSlot();
+    void scheduleRefill();
+    void stopRefill();
+    void refillOne();
+  private:
+    ThreadPool &workers;
+    std::vector<Slot> slots;
+    size_t depth = 0;
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::stop_source refillStop;
+    uint64_t optionsVersion = 0;
+    bool refilling = false;
+    bool stopping = false;
+};
+
+#endif //!PUZZLE_POOL_H
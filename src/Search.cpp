@@ -0,0 +1,90 @@
+#include "Search.h"
+
+#include <algorithm>
+
+bool Search::reset(const NumberGrid &board, const SolverOptions &searchOptions) {
+  options = searchOptions;
+  depth = 0;
+  counters = {};
+
+  const bool consistent = grid.load(board);
+  next = consistent ? Step::Enter : Step::Done;
+  return consistent;
+}
+
+void Search::branchOn(int cell, uint16_t digits) {
+  Frame &frame = stack[0];
+  frame.entryMark = frame.branchMark = grid.mark();
+  frame.remaining = grid.candidates(cell) & digits;
+  frame.cell = static_cast<uint8_t>(cell);
+  depth = 1;
+  next = Step::Advance;
+}
+
+SearchStatus Search::run(uint64_t nodeBudget) {
+  uint64_t visited = 0;
+  while (next != Step::Done) {
+    if (next == Step::Enter) {
+      if (nodeBudget != 0 && visited == nodeBudget) {
+        return SearchStatus::Suspended;
+      }
+      if (options.stopRequested(counters.nodes)) {
+        counters.cancelled = true;
+        return SearchStatus::Cancelled;
+      }
+      ++visited;
+      ++counters.nodes;
+      counters.maxDepth = std::max(counters.maxDepth, depth);
+
+      entryMark = grid.mark();
+      next = Step::Advance;
+      if (options.propagate) {
+        const bool consistent = grid.propagate();
+        counters.propagations += grid.mark() - entryMark;
+        if (!consistent) {
+          ++counters.backtracks;
+          grid.undo(entryMark);
+          continue;
+        }
+      }
+
+      if (grid.emptyCount() == 0) {
+        ++counters.solutions;
+        return SearchStatus::Solved;
+      }
+
+      const int cell = grid.selectCell();
+      Frame &frame = stack[depth++];
+      frame.entryMark = entryMark;
+      frame.branchMark = grid.mark();
+      frame.remaining = grid.candidates(cell);
+      frame.cell = static_cast<uint8_t>(cell);
+      continue;
+    }
+
+    if (depth == 0) {
+      grid.undo(entryMark);
+      next = Step::Done;
+      break;
+    }
+
+    Frame &frame = stack[depth - 1];
+    grid.undo(frame.branchMark);
+    if (frame.remaining == 0) {
+      ++counters.backtracks;
+      grid.undo(frame.entryMark);
+      entryMark = frame.entryMark;
+      --depth;
+      continue;
+    }
+
+    grid.place(frame.cell, lowestDigit(frame.remaining));
+    frame.remaining &= frame.remaining - 1;
+    next = Step::Enter;
+  }
+  return SearchStatus::Exhausted;
+}
+
+void Search::solution(NumberGrid &board) const {
+  grid.store(board);
+}
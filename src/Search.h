@@ -0,0 +1,46 @@
+#pragma once
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "CandidateGrid.h"
+#include "Solver.h"
+
+enum class SearchStatus {
+  Solved,
+  Exhausted,
+  Suspended,
+  Cancelled
+};
+
+class Search {
+  public:
+    bool reset(const NumberGrid &board, const SolverOptions &options = {});
+    void branchOn(int cell, uint16_t digits);
+    SearchStatus run(uint64_t nodeBudget = 0);
+    void solution(NumberGrid &board) const;
+    uint64_t nodes() const { return counters.nodes; }
+    const SolverStats &stats() const { return counters; }
+  private:
+    enum class Step {
+      Enter,
+      Advance,
+      Done
+    };
+
+    struct Frame {
+      int entryMark = 0;
+      int branchMark = 0;
+      uint16_t remaining = 0;
+      uint8_t cell = 0;
+    };
+  private:
+    CandidateGrid grid;
+    SolverOptions options;
+    std::array<Frame, CELL_COUNT> stack{};
+    int depth = 0;
+    int entryMark = 0;
+    Step next = Step::Done;
+    SolverStats counters{};
+};
+
+#endif //!SEARCH_H
@@ -1,4 +1,133 @@
 #include "Solver.h"
+#include "Search.h"
+#include "SolverEngine.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+  struct CumulativeStats {
+    std::atomic<uint64_t> nodes = 0;
+    std::atomic<uint64_t> backtracks = 0;
+    std::atomic<uint64_t> propagations = 0;
+    std::atomic<uint64_t> solutions = 0;
+    std::atomic<int> maxDepth = 0;
+    std::atomic<int64_t> elapsedNs = 0;
+  } totals;
+
+  void finishCall(SolverStats &stats, std::chrono::steady_clock::time_point start, const SolverOptions &options) {
+    stats.elapsed = std::chrono::steady_clock::now() - start;
+    recordSolverStats(stats);
+    if (options.stats) {
+      *options.stats = stats;
+    }
+  }
+
+  uint16_t peerDigits(const NumberGrid &board, int cell) {
+    uint16_t mask = 0;
+    for (int peer : PEERS[cell]) {
+      const int value = board[rowOf(peer)][colOf(peer)];
+      if (value != 0) {
+        mask |= digitBit(value);
+      }
+    }
+    return mask;
+  }
+}
+
+void SolverStats::add(const SolverStats &other) {
+  nodes += other.nodes;
+  backtracks += other.backtracks;
+  propagations += other.propagations;
+  solutions += other.solutions;
+  maxDepth = std::max(maxDepth, other.maxDepth);
+  elapsed += other.elapsed;
+  cancelled = cancelled || other.cancelled;
+}
+
+void recordSolverStats(const SolverStats &stats) {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  totals.nodes.fetch_add(stats.nodes, relaxed);
+  totals.backtracks.fetch_add(stats.backtracks, relaxed);
+  totals.propagations.fetch_add(stats.propagations, relaxed);
+  totals.solutions.fetch_add(stats.solutions, relaxed);
+  totals.elapsedNs.fetch_add(stats.elapsed.count(), relaxed);
+
+  int depth = totals.maxDepth.load(relaxed);
+  while (depth < stats.maxDepth && !totals.maxDepth.compare_exchange_weak(depth, stats.maxDepth, relaxed)) {
+  }
+}
+
+SolverStats cumulativeSolverStats() {
+  SolverStats stats;
+  stats.nodes = totals.nodes;
+  stats.backtracks = totals.backtracks;
+  stats.propagations = totals.propagations;
+  stats.solutions = totals.solutions;
+  stats.maxDepth = totals.maxDepth;
+  stats.elapsed = std::chrono::nanoseconds(totals.elapsedNs);
+  return stats;
+}
+
+void resetCumulativeSolverStats() {
+  totals.nodes = 0;
+  totals.backtracks = 0;
+  totals.propagations = 0;
+  totals.solutions = 0;
+  totals.maxDepth = 0;
+  totals.elapsedNs = 0;
+}
+
+BoardCheck checkBoard(const NumberGrid &board) {
+  BoardCheck check;
+  std::array<uint16_t, BOARD_DIM> rowSeen{}, colSeen{}, boxSeen{};
+  std::array<uint16_t, BOARD_DIM> rowDup{}, colDup{}, boxDup{};
+  bool outOfRange = false;
+
+  for (int r = 0; r < BOARD_DIM; ++r) {
+    for (int c = 0; c < BOARD_DIM; ++c) {
+      const int value = board[r][c];
+      if (value == 0) {
+        check.full = false;
+        continue;
+      }
+      if (value > BOARD_DIM) {
+        outOfRange = true;
+        continue;
+      }
+
+      const uint16_t bit = digitBit(value);
+      const int box = (r / SUBGRID_SIZE) * SUBGRID_SIZE + c / SUBGRID_SIZE;
+      rowDup[r] |= rowSeen[r] & bit;
+      colDup[c] |= colSeen[c] & bit;
+      boxDup[box] |= boxSeen[box] & bit;
+      rowSeen[r] |= bit;
+      colSeen[c] |= bit;
+      boxSeen[box] |= bit;
+    }
+  }
+
+  uint16_t anyDup = 0;
+  for (int i = 0; i < BOARD_DIM; ++i) {
+    anyDup |= rowDup[i] | colDup[i] | boxDup[i];
+  }
+
+  if (anyDup == 0 && !outOfRange) {
+    return check;
+  }
+
+  check.valid = false;
+  for (int r = 0; r < BOARD_DIM; ++r) {
+    for (int c = 0; c < BOARD_DIM; ++c) {
+      const int value = board[r][c];
+      const int box = (r / SUBGRID_SIZE) * SUBGRID_SIZE + c / SUBGRID_SIZE;
+      if (value > BOARD_DIM || (value != 0 && ((rowDup[r] | colDup[c] | boxDup[box]) & digitBit(value)))) {
+        check.conflicts[check.conflictCount++] = static_cast<uint8_t>(r * BOARD_DIM + c);
+      }
+    }
+  }
+  return check;
+}
 
 bool isConflicting(const NumberGrid &board, int row, int col) {
   const int value = board[row][col];
@@ -36,20 +165,34 @@ bool isConflicting(const NumberGrid &board, int row, int col) {
   return false;
 }
 
-bool isSolved(const NumberGrid &board) {
-  bool full = true;
-  for (int r = 0; r < BOARD_DIM; ++r) {
-    for (int c = 0; c < BOARD_DIM; ++c) {
-      if (board[r][c] == 0) {
-        full = false;
-      }
+bool isForced(const NumberGrid &board, int row, int col, int digit) {
+  const int cell = row * BOARD_DIM + col;
+  const uint16_t bit = digitBit(digit);
+  if ((peerDigits(board, cell) | bit) == ALL_DIGITS) {
+    return true;
+  }
 
-      if (isConflicting(board, r, c)) {
-        return false;
+  const int units[] = { rowOf(cell), BOARD_DIM + colOf(cell), 2 * BOARD_DIM + boxOf(cell) };
+  for (int unit : units) {
+    bool elsewhere = false;
+    for (int other : UNITS[unit]) {
+      const int value = board[rowOf(other)][colOf(other)];
+      if (other != cell && (value == digit || (value == 0 && !(peerDigits(board, other) & bit)))) {
+        elsewhere = true;
+        break;
       }
     }
+
+    if (!elsewhere) {
+      return true;
+    }
   }
-  return full;
+  return false;
+}
+
+bool isSolved(const NumberGrid &board) {
+  const BoardCheck check = checkBoard(board);
+  return check.full && check.valid;
 }
 
 bool findEmptyCell(const NumberGrid &board, int &row, int &col) {
@@ -64,22 +207,16 @@ bool findEmptyCell(const NumberGrid &board, int &row, int &col) {
 }
 
 bool solveSudoku(NumberGrid &board) {
-  int row, col;
-  if (!findEmptyCell(board, row, col)) {
-    return true;
-  }
-
-  for (int num = 1; num <= 9; ++num) {
-    board[row][col] = num;
-    if (!isConflicting(board, row, col)) {
-      if (solveSudoku(board)) {
-        return true;
-      }
-    }
-  }
+  return solveSudoku(board, SolverOptions{});
+}
 
-  board[row][col] = 0;
-  return false;
+bool solveSudoku(NumberGrid &board, const SolverOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  SolverEngine &engine = options.engine ? *options.engine : defaultSolverEngine();
+  SolverStats stats;
+  const bool solved = engine.solve(board, options, stats);
+  finishCall(stats, start, options);
+  return solved;
 }
 
 int countSolutions(NumberGrid &board) {
@@ -88,22 +225,81 @@ int countSolutions(NumberGrid &board) {
   return count;
 }
 
+int countSolutions(const NumberGrid &board, int limit, const SolverOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  SolverEngine &engine = options.engine ? *options.engine : defaultSolverEngine();
+  SolverStats stats;
+  const int count = engine.count(board, limit, options, stats);
+  finishCall(stats, start, options);
+  return count;
+}
+
 void solveAndCount(NumberGrid &board, int &count) {
   if (count >= 2) {
     return;
   }
 
-  int row, col;
-  if (!findEmptyCell(board, row, col)) {
-    ++count;
-    return;
+  count += countSolutions(board, 2 - count);
+}
+
+bool hasAlternateSolution(const NumberGrid &puzzle, const NumberGrid &solution, int row, int col,
+                          const SolverOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  SolverEngine &engine = options.engine ? *options.engine : defaultSolverEngine();
+  SolverStats stats;
+  bool found = false;
+
+  if (isForced(puzzle, row, col, solution[row][col])) {
+    found = false;
+  } else if (engine.supportsGuidedSearch()) {
+    Search search;
+    if (search.reset(puzzle, options)) {
+      search.branchOn(row * BOARD_DIM + col, ALL_DIGITS & ~digitBit(solution[row][col]));
+      found = search.run() == SearchStatus::Solved;
+    }
+    stats = search.stats();
+  } else {
+    SolverStats callStats;
+    NumberGrid board = puzzle;
+    for (int digit = 1; digit <= 9 && !found; ++digit) {
+      board[row][col] = static_cast<uint8_t>(digit);
+      if (digit == solution[row][col] || isConflicting(board, row, col)) {
+        continue;
+      }
+
+      found = engine.count(board, 1, options, callStats) > 0;
+      stats.add(callStats);
+    }
+  }
+
+  finishCall(stats, start, options);
+  return found || stats.cancelled;
+}
+
+bool hasAlternateSolution(const NumberGrid &puzzle, const NumberGrid &solution, std::span<const uint8_t> cells,
+                          const SolverOptions &options) {
+  SolverStats total;
+  SolverStats callStats;
+  SolverOptions callOptions = options;
+  callOptions.stats = &callStats;
+
+  NumberGrid board = puzzle;
+  for (int cell : cells) {
+    board[cell / BOARD_DIM][cell % BOARD_DIM] = solution[cell / BOARD_DIM][cell % BOARD_DIM];
   }
 
-  for (int num = 1; num <= 9; ++num) {
-    board[row][col] = num;
-    if (!isConflicting(board, row, col)) {
-      solveAndCount(board, count);
+  bool found = false;
+  for (int cell : cells) {
+    board[cell / BOARD_DIM][cell % BOARD_DIM] = 0;
+    found = hasAlternateSolution(board, solution, cell / BOARD_DIM, cell % BOARD_DIM, callOptions);
+    total.add(callStats);
+    if (found) {
+      break;
     }
-    board[row][col] = 0;
   }
+
+  if (options.stats) {
+    *options.stats = total;
+  }
+  return found;
 }
@@ -2,13 +2,63 @@
 #ifndef SOLVER_H
 #define SOLVER_H
 
-#include "Common.h"
+#include "Board.h"
 
+#include <chrono>
+#include <span>
+#include <stop_token>
+
+class SolverEngine;
+
+struct BoardCheck {
+  bool full = true;
+  bool valid = true;
+  int conflictCount = 0;
+  std::array<uint8_t, CELL_COUNT> conflicts{};
+};
+
+struct SolverStats {
+  uint64_t nodes = 0;
+  uint64_t backtracks = 0;
+  uint64_t propagations = 0;
+  uint64_t solutions = 0;
+  int maxDepth = 0;
+  std::chrono::nanoseconds elapsed{};
+  bool cancelled = false;
+
+  void add(const SolverStats &other);
+};
+
+constexpr uint64_t STOP_CHECK_NODES = 256;
+
+struct SolverOptions {
+  bool propagate = true;
+  SolverStats *stats = nullptr;
+  SolverEngine *engine = nullptr;
+  std::stop_token stop{};
+
+  bool stopRequested(uint64_t nodes) const {
+    return nodes % STOP_CHECK_NODES == 0 && stop.stop_requested();
+  }
+};
+
+void recordSolverStats(const SolverStats &stats);
+SolverStats cumulativeSolverStats();
+void resetCumulativeSolverStats();
+
+BoardCheck checkBoard(const NumberGrid &board);
 bool isConflicting(const NumberGrid &board, int row, int col);
+bool isForced(const NumberGrid &board, int row, int col, int digit);
 bool isSolved(const NumberGrid &board);
 bool findEmptyCell(const NumberGrid &board, int &row, int &col);
 bool solveSudoku(NumberGrid &board);
+bool solveSudoku(NumberGrid &board, const SolverOptions &options);
 int countSolutions(NumberGrid &board);
+int countSolutions(const NumberGrid &board, int limit, const SolverOptions &options = {});
 void solveAndCount(NumberGrid &board, int &count);
+bool hasAlternateSolution(const NumberGrid &puzzle, const NumberGrid &solution, int row, int col,
+                          const SolverOptions &options = {});
+bool hasAlternateSolution(const NumberGrid &puzzle, const NumberGrid &solution, std::span<const uint8_t> cells,
+                          const SolverOptions &options = {});
 
 #endif //!SOVER_H
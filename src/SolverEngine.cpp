@@ -0,0 +1,185 @@
+#include "SolverEngine.h"
+#include "DancingLinks.h"
+#include "Search.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+  class BitmaskEngine : public SolverEngine {
+    public:
+      std::string_view name() const override { return "bitmask"; }
+      bool supportsGuidedSearch() const override { return true; }
+
+      bool solve(NumberGrid &board, const SolverOptions &options, SolverStats &stats) override {
+        Search search;
+        const bool solved = search.reset(board, options) && search.run() == SearchStatus::Solved;
+        if (solved) {
+          search.solution(board);
+        }
+        stats = search.stats();
+        return solved;
+      }
+
+      int count(const NumberGrid &board, int limit, const SolverOptions &options,
+                SolverStats &stats, NumberGrid *firstSolution) override {
+        int found = 0;
+        Search search;
+        if (limit > 0 && search.reset(board, options)) {
+          while (found < limit && search.run() == SearchStatus::Solved) {
+            if (found++ == 0 && firstSolution) {
+              search.solution(*firstSolution);
+            }
+          }
+        }
+        stats = search.stats();
+        return found;
+      }
+  };
+
+  class DancingLinksEngine : public SolverEngine {
+    public:
+      std::string_view name() const override { return "dlx"; }
+
+      bool solve(NumberGrid &board, const SolverOptions &options, SolverStats &stats) override {
+        DancingLinks &dlx = threadInstance();
+        const bool solved = dlx.solve(board, options.stop);
+        stats = dlx.stats();
+        return solved;
+      }
+
+      int count(const NumberGrid &board, int limit, const SolverOptions &options,
+                SolverStats &stats, NumberGrid *firstSolution) override {
+        DancingLinks &dlx = threadInstance();
+        const int found = dlx.count(board, limit, options.stop);
+        if (found > 0 && firstSolution) {
+          *firstSolution = board;
+          dlx.firstSolution(*firstSolution);
+        }
+        stats = dlx.stats();
+        return found;
+      }
+    private:
+      static DancingLinks &threadInstance() {
+        thread_local DancingLinks dlx;
+        return dlx;
+      }
+  };
+
+  class ReferenceEngine : public SolverEngine {
+    public:
+      std::string_view name() const override { return "reference"; }
+
+      bool solve(NumberGrid &board, const SolverOptions &options, SolverStats &stats) override {
+        stats = {};
+        if (!SolverEngine::validate(board)) {
+          return false;
+        }
+
+        const bool solved = solveFrom(board, 0, options, stats);
+        stats.solutions = solved ? 1 : 0;
+        return solved;
+      }
+
+      int count(const NumberGrid &board, int limit, const SolverOptions &options,
+                SolverStats &stats, NumberGrid *firstSolution) override {
+        stats = {};
+        int found = 0;
+        NumberGrid work = board;
+        if (limit > 0 && SolverEngine::validate(board)) {
+          countFrom(work, 0, found, limit, options, stats, firstSolution);
+        }
+        stats.solutions = found;
+        return found;
+      }
+    private:
+      static bool solveFrom(NumberGrid &board, int depth, const SolverOptions &options, SolverStats &stats) {
+        if (options.stopRequested(stats.nodes)) {
+          stats.cancelled = true;
+          return false;
+        }
+        ++stats.nodes;
+        stats.maxDepth = std::max(stats.maxDepth, depth);
+
+        int row, col;
+        if (!findEmptyCell(board, row, col)) {
+          return true;
+        }
+
+        for (int num = 1; num <= 9; ++num) {
+          board[row][col] = num;
+          if (!isConflicting(board, row, col) && solveFrom(board, depth + 1, options, stats)) {
+            return true;
+          }
+        }
+
+        board[row][col] = 0;
+        ++stats.backtracks;
+        return false;
+      }
+
+      static void countFrom(NumberGrid &board, int depth, int &found, int limit, const SolverOptions &options,
+                            SolverStats &stats, NumberGrid *firstSolution) {
+        if (options.stopRequested(stats.nodes)) {
+          stats.cancelled = true;
+          return;
+        }
+        ++stats.nodes;
+        stats.maxDepth = std::max(stats.maxDepth, depth);
+
+        int row, col;
+        if (!findEmptyCell(board, row, col)) {
+          if (found++ == 0 && firstSolution) {
+            *firstSolution = board;
+          }
+          return;
+        }
+
+        for (int num = 1; num <= 9 && found < limit; ++num) {
+          board[row][col] = num;
+          if (!isConflicting(board, row, col)) {
+            countFrom(board, depth + 1, found, limit, options, stats, firstSolution);
+          }
+        }
+
+        board[row][col] = 0;
+        ++stats.backtracks;
+      }
+  };
+
+  BitmaskEngine bitmaskEngine;
+  DancingLinksEngine dancingLinksEngine;
+  ReferenceEngine referenceEngine;
+
+  std::atomic<SolverEngine *> activeEngine = &bitmaskEngine;
+}
+
+bool SolverEngine::validate(const NumberGrid &board) const {
+  return checkBoard(board).valid;
+}
+
+const std::vector<SolverEngine *> &solverEngines() {
+  static const std::vector<SolverEngine *> engines = {
+    &bitmaskEngine,
+    &dancingLinksEngine,
+    &referenceEngine
+  };
+  return engines;
+}
+
+SolverEngine *findSolverEngine(std::string_view name) {
+  for (SolverEngine *engine : solverEngines()) {
+    if (engine->name() == name) {
+      return engine;
+    }
+  }
+  return nullptr;
+}
+
+SolverEngine &defaultSolverEngine() {
+  return *activeEngine;
+}
+
+void setDefaultSolverEngine(SolverEngine &engine) {
+  activeEngine = &engine;
+}
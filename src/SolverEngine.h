@@ -0,0 +1,27 @@
+#pragma once
+#ifndef SOLVER_ENGINE_H
+#define SOLVER_ENGINE_H
+
+#include "Board.h"
+#include "Solver.h"
+
+#include <string_view>
+#include <vector>
+
+class SolverEngine {
+  public:
+    virtual ~SolverEngine() = default;
+    virtual std::string_view name() const = 0;
+    virtual bool solve(NumberGrid &board, const SolverOptions &options, SolverStats &stats) = 0;
+    virtual int count(const NumberGrid &board, int limit, const SolverOptions &options,
+                      SolverStats &stats, NumberGrid *firstSolution = nullptr) = 0;
+    virtual bool validate(const NumberGrid &board) const;
+    virtual bool supportsGuidedSearch() const { return false; }
+};
+
+const std::vector<SolverEngine *> &solverEngines();
+SolverEngine *findSolverEngine(std::string_view name);
+SolverEngine &defaultSolverEngine();
+void setDefaultSolverEngine(SolverEngine &engine);
+
+#endif //!SOLVER_ENGINE_H
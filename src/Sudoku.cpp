@@ -1,13 +1,19 @@
 #include "Sudoku.h"
 #include "Solver.h"
+#include "SolverEngine.h"
+#include "Generator.h"
 #include "TextureManager.h"
+#include "ThreadPool.h"
+#include "PuzzlePool.h"
 
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_sdl2.h"
 #include "imgui/imgui_impl_sdlrenderer2.h"
 
+#include <charconv>
 #include <iostream>
 #include <fstream>
+#include <mutex>
 #include <random>
 
 #include <SDL2/SDL.h>
@@ -16,11 +22,15 @@
 
 Sudoku::Sudoku()
   : startTime(std::chrono::steady_clock::now()) {
+  solverOptions.engine = &defaultSolverEngine();
+  generatorOptions.engine = &defaultSolverEngine();
   calculateLayout();
 }
 
 Sudoku::~Sudoku() {
-  if (generationThread.joinable()) generationThread.join();
+  gameStop.request_stop();
+  puzzlePool.reset();
+  solverPool.reset();
 
   Mix_FreeChunk(moveSound);
   Mix_FreeChunk(inputSound);
@@ -41,6 +51,62 @@ Sudoku::~Sudoku() {
   SDL_Quit();
 }
 
+bool Sudoku::parseArguments(int argc, char **argv) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    std::string_view name;
+    std::vector<SolverOptions *> targets;
+
+    if (arg.starts_with("--engine=")) {
+      targets = { &solverOptions, &generatorOptions };
+    } else if (arg.starts_with("--solve-engine=")) {
+      targets = { &solverOptions };
+    } else if (arg.starts_with("--generator-engine=")) {
+      targets = { &generatorOptions };
+    } else if (arg == "--no-propagation") {
+      solverOptions.propagate = generatorOptions.propagate = false;
+      continue;
+    } else if (arg.starts_with("--bank=")) {
+      bankPath = arg.substr(arg.find('=') + 1);
+      continue;
+    } else if (arg.starts_with("--pool-depth=") || arg.starts_with("--threads=")) {
+      const std::string_view value = arg.substr(arg.find('=') + 1);
+      size_t number = 0;
+      const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+      if (error != std::errc() || end != value.data() + value.size()) {
+        std::cerr << "Invalid value: " << arg << std::endl;
+        return false;
+      }
+
+      if (arg.starts_with("--threads=")) {
+        workerThreads = static_cast<unsigned>(number);
+      } else {
+        puzzlePoolDepth = number;
+      }
+      continue;
+    } else {
+      std::cerr << "Unknown argument: " << arg << std::endl;
+      return false;
+    }
+
+    name = arg.substr(arg.find('=') + 1);
+    SolverEngine *engine = findSolverEngine(name);
+    if (!engine) {
+      std::cerr << "Unknown solver engine '" << name << "'. Available:";
+      for (SolverEngine *available : solverEngines()) {
+        std::cerr << ' ' << available->name();
+      }
+      std::cerr << std::endl;
+      return false;
+    }
+
+    for (SolverOptions *target : targets) {
+      target->engine = engine;
+    }
+  }
+  return true;
+}
+
 bool Sudoku::init() {
   if (SDL_Init(SDL_INIT_VIDEO) < 0) {
     std::cerr << "SDL couldn't initialize! SDL Error: " << SDL_GetError() << std::endl;
@@ -167,6 +233,8 @@ void Sudoku::render() {
                                         finalElapsedDuration.count() / 60, finalElapsedDuration.count() % 60);
     showOverlayMessage("GAME OVER", finalTime + " | Press \'N\' for Menu", { 0xFF, 0x32, 0x32 });
   } else {
+    boardCheck = checkBoard(board);
+    highlightConflicts();
     highlightGrid();
     showGridLines();
     showNumbers();
@@ -232,6 +300,44 @@ void Sudoku::renderUI() {
   if (ImGui::RadioButton("5", maxMistakes == 5)) maxMistakes = 5; ImGui::SameLine();
   if (ImGui::RadioButton("Off", maxMistakes == 0)) maxMistakes = 0;
 
+  ImGui::Spacing();
+
+  auto engineCombo = [](const char *label, SolverOptions &options) {
+    const std::string preview(options.engine->name());
+    bool changed = false;
+    if (ImGui::BeginCombo(label, preview.c_str())) {
+      for (SolverEngine *engine : solverEngines()) {
+        const std::string name(engine->name());
+        if (ImGui::Selectable(name.c_str(), engine == options.engine)) {
+          changed = engine != options.engine;
+          options.engine = engine;
+        }
+      }
+      ImGui::EndCombo();
+    }
+    return changed;
+  };
+
+  ImGui::Text("Solver Engine ('S' key):");
+  engineCombo("##SolveEngine", solverOptions);
+  ImGui::Text("Generator Engine:");
+  bool generatorChanged = engineCombo("##GeneratorEngine", generatorOptions);
+
+  if (ImGui::Checkbox("Solver Constraint Propagation", &solverOptions.propagate)) {
+    generatorOptions.propagate = solverOptions.propagate;
+    generatorChanged = true;
+  }
+  if (generatorChanged && puzzlePool) {
+    puzzlePool->setSolverOptions(generatorOptions);
+  }
+
+  const char *symmetries[] = { "None", "180-Degree Rotation", "90-Degree Rotation", "Diagonal", "Horizontal Mirror", "Vertical Mirror" };
+  int symmetryMode = static_cast<int>(symmetry);
+  ImGui::Text("Clue Symmetry:");
+  if (ImGui::Combo("##Symmetry", &symmetryMode, symmetries, IM_ARRAYSIZE(symmetries))) {
+    symmetry = static_cast<Symmetry>(symmetryMode);
+  }
+
   ImGui::Separator();
 
   ImGui::SetWindowFontScale(2.f);
@@ -250,6 +356,32 @@ void Sudoku::renderUI() {
   ImGui::SetCursorPosX((windowWidthIm - ImGui::CalcTextSize("Hard").x - 10.f) * 0.5f);
   if (ImGui::RadioButton("Hard", targetClues == 25)) targetClues = 25;
 
+  ImGui::Dummy(ImVec2(0.f, 10.f));
+  ImGui::SetWindowFontScale(1.f);
+  ImGui::Text("Search-Effort Band (overrides clue count):");
+  if (ImGui::RadioButton("Any", hardnessBand < 0)) hardnessBand = -1;
+  for (int band = 0; band < static_cast<int>(HARDNESS_BANDS.size()); ++band) {
+    ImGui::SameLine();
+    if (ImGui::RadioButton(HARDNESS_BANDS[band].name.data(), hardnessBand == band)) hardnessBand = band;
+  }
+
+  for (int band = 0; band < static_cast<int>(HARDNESS_BANDS.size()); ++band) {
+    const HardnessBand &info = HARDNESS_BANDS[band];
+    const std::string guesses = info.maxGuesses == std::numeric_limits<uint64_t>::max()
+      ? std::format("{}+", info.minGuesses)
+      : std::format("{}-{}", info.minGuesses, info.maxGuesses);
+    const BandLatency &latency = bandLatency[band];
+    if (latency.count == 0) {
+      ImGui::Text("%s (%s guesses)", info.name.data(), guesses.c_str());
+      continue;
+    }
+    ImGui::Text("%s (%s guesses): %d puzzles, avg %.1f ms, worst %.1f ms", info.name.data(), guesses.c_str(),
+                latency.count,
+                std::chrono::duration<double, std::milli>(latency.total).count() / latency.count,
+                std::chrono::duration<double, std::milli>(latency.worst).count());
+  }
+  ImGui::SetWindowFontScale(1.5f);
+
   ImGui::Dummy(ImVec2(0.f, 10.f));
 
   ImGui::SetCursorPosX((windowWidthIm - buttonWidth) * 0.5f);
@@ -278,6 +410,26 @@ void Sudoku::renderUI() {
   ImGui::Text("Hard: %s", formatTime(bestTimes.hard).c_str());
   ImGui::Columns(1);
 
+  if (!isGenerating) {
+    const SolverStats totals = cumulativeSolverStats();
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Text("Last Puzzle: %d clues in %.1f ms%s", puzzleClues,
+                std::chrono::duration<double, std::milli>(puzzleElapsed).count(),
+                puzzleMissedTarget ? " (time budget ran out above the target)" : "");
+    ImGui::Text("Solver: %llu nodes, %llu backtracks, depth %d, %.1f ms",
+                static_cast<unsigned long long>(generationStats.nodes),
+                static_cast<unsigned long long>(generationStats.backtracks),
+                generationStats.maxDepth,
+                std::chrono::duration<double, std::milli>(generationStats.elapsed).count());
+    ImGui::Text("Rating: %d (hardest step: %s), %llu guesses, %d attempts", puzzleGrade.score,
+                techniqueName(puzzleGrade.hardest).data(), static_cast<unsigned long long>(puzzleGuesses), puzzleAttempts);
+    ImGui::Text("Session: %llu nodes, %llu propagations, %.1f ms solving",
+                static_cast<unsigned long long>(totals.nodes),
+                static_cast<unsigned long long>(totals.propagations),
+                std::chrono::duration<double, std::milli>(totals.elapsed).count());
+  }
+
   ImGui::End();
 
   ImGui::Render();
@@ -285,6 +437,20 @@ void Sudoku::renderUI() {
 }
 
 void Sudoku::update() {
+  if (const std::shared_ptr<const PuzzleSnapshot> snapshot = publishedPuzzle.exchange(nullptr)) {
+    if (snapshot->game == currentGame) {
+      applyPuzzle(snapshot->puzzle);
+      isGenerating = false;
+    }
+  }
+
+  if (pendingSolve.valid() && pendingSolve.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+    if (const std::optional<NumberGrid> solution = pendingSolve.get()) {
+      board = *solution;
+      isPuzzleSolved = true;
+    }
+  }
+
   if (isGenerating) {
     SDL_Delay(16);
     return;
@@ -323,11 +489,28 @@ void Sudoku::update() {
 }
 
 int Sudoku::run() {
+  solverPool = std::make_unique<ThreadPool>(workerThreads);
   if (!init()) {
     std::cerr << "Failed to initialize\n";
     return 1;
   }
 
+  if (!bankPath.empty()) {
+    puzzleBank.open(bankPath);
+  }
+
+  if (puzzlePoolDepth > 0) {
+    std::vector<GeneratorOptions> kinds;
+    for (int clues : { 45, 40, 35, 30, 25, 22, 17 }) {
+      const RemovalStrategy removal = clues < MINIMAL_CLUE_LIMIT ? RemovalStrategy::Minimal : RemovalStrategy::Serial;
+      kinds.push_back({ .targetClues = clues, .solver = generatorOptions, .removal = removal, .grade = true });
+    }
+    for (int band = 0; band < static_cast<int>(HARDNESS_BANDS.size()); ++band) {
+      kinds.push_back({ .solver = generatorOptions, .grade = true, .band = band });
+    }
+    puzzlePool = std::make_unique<PuzzlePool>(*solverPool, kinds, puzzlePoolDepth);
+  }
+
   initializeNewGame(true);
   while (isRunning) {
     update();
@@ -346,68 +529,86 @@ void Sudoku::initializeNewGame(bool generateNew) {
   startTime = std::chrono::steady_clock::now();
   finalElapsedDuration = std::chrono::seconds(0);
 
-  if (generateNew) {
-    isGenerating = true; 
-    if (generationThread.joinable()) generationThread.join();
-    generationThread = std::thread(&Sudoku::generatePuzzleTask, this);
-  }
-}
-
-void Sudoku::generatePuzzle() {
-  static std::random_device rd;
-  static std::default_random_engine dre(rd());
-
-  selectedRow = dre() % 9;
-  selectedCol = dre() % 9;
-  
-  std::vector<int> nums = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
-  std::shuffle(nums.begin(), nums.end(), dre);
+  gameStop.request_stop();
+  gameStop = {};
+  pendingSolve = {};
+  ++currentGame;
 
-  int index = 0;
-  for (int r = 0; r < 3; ++r) {
-    for (int c = 0; c < 3; ++c) {
-      board[r][c] = nums[index++];
+  if (generateNew) {
+    GeneratedPuzzle pooled;
+    if (symmetry == Symmetry::None && (puzzleBank.draw(targetClues, hardnessBand, pooled)
+        || (puzzlePool && puzzlePool->tryPop(targetClues, hardnessBand, pooled)))) {
+      isGenerating = false;
+      applyPuzzle(pooled);
+      return;
     }
-  }
-  
-  NumberGrid tempBoard = {};
-  solveSudoku(tempBoard);
-
-  solvedBoard = tempBoard;
-  board = tempBoard;
-  fixedBoard = tempBoard;
 
-  std::vector<std::pair<int, int>> cells;
-  for (int r = 0; r < BOARD_DIM; ++r) {
-    for (int c = 0; c < BOARD_DIM; ++c) {
-      cells.emplace_back(r, c);
+    if (puzzlePool) {
+      puzzlePool->interruptRefill();
     }
+
+    isGenerating = true;
+    solverPool->submit([this, game = currentGame, options = puzzleOptions()] {
+      thread_local std::default_random_engine rng(std::random_device{}());
+      GeneratedPuzzle puzzle = generatePuzzle(options, rng);
+      if (!puzzle.cancelled) {
+        publishPuzzle(game, std::move(puzzle));
+      }
+    }, TaskPriority::High);
   }
-  std::shuffle(cells.begin(), cells.end(), dre);
-  
-  int removedCount = 0;
-  int maxRemovals = BOARD_DIM * BOARD_DIM - targetClues;
+}
 
-  for (const auto &cell : cells) {
-    if (removedCount >= maxRemovals) break;
-    int r = cell.first;
-    int c = cell.second;
+void Sudoku::publishPuzzle(uint64_t game, GeneratedPuzzle puzzle) {
+  const auto snapshot = std::make_shared<const PuzzleSnapshot>(PuzzleSnapshot{ game, std::move(puzzle) });
+  std::shared_ptr<const PuzzleSnapshot> current = publishedPuzzle.load();
+  do {
+    if (current && current->game > game) {
+      return;
+    }
+  } while (!publishedPuzzle.compare_exchange_weak(current, snapshot));
+}
 
-    if (board[r][c] == 0) continue;
+void Sudoku::applyPuzzle(const GeneratedPuzzle &puzzle) {
+  static std::default_random_engine dre(std::random_device{}());
 
-    int backupVal = board[r][c];
-    board[r][c] = 0;
+  selectedRow = dre() % 9;
+  selectedCol = dre() % 9;
 
-    if (countSolutions(board) == 1) {
-      ++removedCount;
-    } else {
-      board[r][c] = backupVal;
-    }
+  generationStats = puzzle.stats;
+  puzzleGrade = puzzle.grade;
+  puzzleGuesses = puzzle.guesses;
+  puzzleAttempts = puzzle.attempts;
+  puzzleClues = puzzle.clues;
+  puzzleMissedTarget = puzzle.missedTarget;
+  puzzleElapsed = puzzle.elapsed;
+  if (puzzle.band >= 0 && puzzle.attempts > 0) {
+    BandLatency &latency = bandLatency[puzzle.band];
+    ++latency.count;
+    latency.total += puzzle.elapsed;
+    latency.worst = std::max(latency.worst, puzzle.elapsed);
   }
-
+  solvedBoard = puzzle.solution;
+  board = puzzle.puzzle;
   fixedBoard = board;
 }
 
+GeneratorOptions Sudoku::puzzleOptions() const {
+  GeneratorOptions options;
+  options.targetClues = targetClues;
+  options.solver = generatorOptions;
+  options.solver.stop = gameStop.get_token();
+  options.pool = solverPool.get();
+  options.grade = true;
+  options.band = hardnessBand;
+  options.symmetry = symmetry;
+  if (targetClues < MINIMAL_CLUE_LIMIT && hardnessBand < 0 && symmetry == Symmetry::None) {
+    options.removal = RemovalStrategy::Minimal;
+  } else if (solverPool->size() > 1) {
+    options.removal = RemovalStrategy::Speculative;
+  }
+  return options;
+}
+
 void Sudoku::calculateLayout() {
   SDL_GetWindowSize(window, &windowWidth, &windowHeight);
 
@@ -492,8 +693,12 @@ void Sudoku::handleKeyboardEvents(int key) {
 
   if (!isPaused && !isPuzzleSolved) {
     if (key == SDLK_s) {
-      if (solveSudoku(board)) {
-        isPuzzleSolved = true;
+      if (!pendingSolve.valid()) {
+        SolverOptions options = solverOptions;
+        options.stop = gameStop.get_token();
+        pendingSolve = solverPool->async(TaskPriority::High, [puzzle = board, options]() mutable {
+          return solveSudoku(puzzle, options) ? std::optional<NumberGrid>(puzzle) : std::nullopt;
+        });
       }
     }
 
@@ -551,7 +756,8 @@ void Sudoku::handleNumericKeys(int key) {
           Mix_PlayChannel(-1, inputSound, 0);
         }
 
-        if (isSolved(board)) {
+        boardCheck = checkBoard(board);
+        if (boardCheck.full && boardCheck.valid) {
           isPuzzleSolved = true;
           Mix_PlayChannel(-1, winSound, 0);
         }
@@ -618,6 +824,20 @@ void Sudoku::highlightGrid() {
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 }
 
+void Sudoku::highlightConflicts() {
+  if (boardCheck.valid) return;
+
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0xFF, 0x80, 0x80, 0x60);
+  for (int i = 0; i < boardCheck.conflictCount; ++i) {
+    const int row = boardCheck.conflicts[i] / BOARD_DIM;
+    const int col = boardCheck.conflicts[i] % BOARD_DIM;
+    SDL_Rect conflictRect = { offsetX + col * cellSize, offsetY + row * cellSize, cellSize, cellSize };
+    SDL_RenderFillRect(renderer, &conflictRect);
+  }
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
 void Sudoku::showGridLines() {
   if (selectedRow != -1 && selectedCol != -1) {
     SDL_SetRenderDrawColor(renderer, 0x90, 0xEE, 0x90, 0xFF);
@@ -709,10 +929,14 @@ void Sudoku::showHud() {
   int seconds = totalSeconds % 60;
   std::string diffText;
   
-  if      (targetClues >= 40) diffText += "Easy";
+  if      (hardnessBand >= 0) diffText += HARDNESS_BANDS[hardnessBand].name;
+  else if (targetClues >= 40) diffText += "Easy";
   else if (targetClues >= 30) diffText += "Medium";
   else if (targetClues >= 20) diffText += "Hard";
   else                        diffText += "Expert";
+  if (puzzleMissedTarget) {
+    diffText += std::format(" ({} clues)", puzzleClues);
+  }
 
   std::string mistakeStr;
   if (maxMistakes > 0) {
@@ -921,25 +1145,14 @@ void Sudoku::loadScores() {
 }
 
 void Sudoku::saveScores() {
-  std::ofstream file("bestTimes.dat");
-  if (file.is_open()) {
-    file << bestTimes.easy << ' ' << bestTimes.medium << ' ' << bestTimes.hard << ' ';
-    file.close();
-  }
-}
-
-void Sudoku::generatePuzzleTask() {
-  auto taskStart = std::chrono::steady_clock::now();
-
-  generatePuzzle();
-  fixedBoard = board;
-
-  auto taskEnd = std::chrono::steady_clock::now();
-  auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(taskEnd - taskStart);
-
-  if (elapsed < std::chrono::milliseconds(350)) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(350) - elapsed);
-  }
-  
-  isGenerating = false;
+  solverPool->submit([times = bestTimes] {
+    static std::mutex fileMutex;
+    std::lock_guard lock(fileMutex);
+
+    std::ofstream file("bestTimes.dat");
+    if (file.is_open()) {
+      file << times.easy << ' ' << times.medium << ' ' << times.hard << ' ';
+      file.close();
+    }
+  }, TaskPriority::Low);
 }
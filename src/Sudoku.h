@@ -3,19 +3,28 @@
 #define SUDOKU_H
 
 #include "Common.h"
+#include "Generator.h"
+#include "PuzzleBank.h"
+#include "Solver.h"
 
-#include <chrono>
 #include <atomic>
-#include <thread>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <optional>
+#include <stop_token>
+#include <string>
 #include <string_view>
 
 class TextureManager;
+class ThreadPool;
+class PuzzlePool;
 
 class Sudoku {
   public:
     Sudoku();
     ~Sudoku();
+    bool parseArguments(int argc, char **argv);
     int run();
   private:
     bool init();
@@ -25,7 +34,9 @@ class Sudoku {
     void renderUI();
     void update();
     void initializeNewGame(bool generateNew);
-    void generatePuzzle();
+    GeneratorOptions puzzleOptions() const;
+    void applyPuzzle(const GeneratedPuzzle &puzzle);
+    void publishPuzzle(uint64_t game, GeneratedPuzzle puzzle);
     void calculateLayout();
     void handleMouseEvents();
     void handleKeyboardEvents(int key);
@@ -33,6 +44,7 @@ class Sudoku {
     void handleNumericKeys(int key);
     void handleDifficultyKeys(int key);
     void highlightGrid();
+    void highlightConflicts();
     void showGridLines();
     Color getCellColor(int row, int col);
     void showNumbers();
@@ -43,8 +55,6 @@ class Sudoku {
     void showNumberStats();
     void loadScores();
     void saveScores();
-  private:
-    void generatePuzzleTask();
   private:
     SDL_Window *window = nullptr;
     SDL_Renderer *renderer = nullptr;
@@ -55,6 +65,9 @@ class Sudoku {
     Mix_Chunk *mistakeSound = nullptr;
 
     std::unique_ptr<TextureManager> textureManager;
+    std::unique_ptr<ThreadPool> solverPool;
+    std::unique_ptr<PuzzlePool> puzzlePool;
+    PuzzleBank puzzleBank;
 
     bool isRunning = true;
     bool isPaused = false;
@@ -62,8 +75,21 @@ class Sudoku {
     bool isShowingMenu = true;
     bool isMuted = false;
 
+    SolverOptions solverOptions{};
+    SolverOptions generatorOptions{};
+    SolverStats generationStats{};
+    PuzzleGrade puzzleGrade{};
+    uint64_t puzzleGuesses = 0;
+    int puzzleAttempts = 0;
+    int puzzleClues = 0;
+    bool puzzleMissedTarget = false;
+    std::chrono::nanoseconds puzzleElapsed{};
+
     int fontSizeMode = 1;
     int maxMistakes = 3;
+    size_t puzzlePoolDepth = 2;
+    unsigned workerThreads = 0;
+    std::string bankPath = "res/puzzles.bank";
 
     int selectedRow = -1;
     int selectedCol = -1;
@@ -71,6 +97,7 @@ class Sudoku {
     NumberGrid board{};
     NumberGrid fixedBoard{};
     NumberGrid solvedBoard{};
+    BoardCheck boardCheck{};
 
     std::chrono::steady_clock::time_point startTime;
     std::chrono::steady_clock::time_point pauseStartTime{};
@@ -79,6 +106,8 @@ class Sudoku {
 
     int mistakeCount = 0;
     int targetClues = 45;
+    int hardnessBand = -1;
+    Symmetry symmetry = Symmetry::None;
 
     int windowWidth = 800;
     int windowHeight = 800;
@@ -93,9 +122,24 @@ class Sudoku {
       int medium = 99999;
       int hard = 99999;
     } bestTimes{};
+
+    struct BandLatency {
+      int count = 0;
+      std::chrono::nanoseconds total{};
+      std::chrono::nanoseconds worst{};
+    };
+    std::array<BandLatency, HARDNESS_BANDS.size()> bandLatency{};
   private:
-    std::atomic_bool isGenerating = false;
-    std::thread generationThread;
+    struct PuzzleSnapshot {
+      uint64_t game = 0;
+      GeneratedPuzzle puzzle{};
+    };
+
+    bool isGenerating = false;
+    uint64_t currentGame = 0;
+    std::stop_source gameStop;
+    std::atomic<std::shared_ptr<const PuzzleSnapshot>> publishedPuzzle;
+    std::future<std::optional<NumberGrid>> pendingSolve;
 };
 
 #endif //!SUDOKU_H
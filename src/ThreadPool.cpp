@@ -0,0 +1,146 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+  thread_local const ThreadPool *currentPool = nullptr;
+  thread_local unsigned currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (unsigned i = 0; i < threadCount; ++i) {
+    queues.push_back(std::make_unique<Queue>());
+  }
+
+  for (unsigned i = 0; i < threadCount; ++i) {
+    threads.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleepMutex);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> task, TaskPriority priority) {
+  const unsigned target = currentPool == this
+    ? currentWorker
+    : nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+
+  {
+    std::lock_guard lock(sleepMutex);
+    ++pending;
+  }
+
+  {
+    std::lock_guard lock(queues[target]->mutex);
+    queues[target]->tasks[static_cast<size_t>(priority)].push_back(std::move(task));
+  }
+  wake.notify_one();
+}
+
+bool ThreadPool::popTask(unsigned home, TaskPriority lowest, std::function<void()> &task) {
+  for (size_t level = 0; level <= static_cast<size_t>(lowest); ++level) {
+    {
+      Queue &own = *queues[home];
+      std::lock_guard lock(own.mutex);
+      auto &tasks = own.tasks[level];
+      if (!tasks.empty()) {
+        if (level == static_cast<size_t>(TaskPriority::Normal)) {
+          task = std::move(tasks.back());
+          tasks.pop_back();
+        } else {
+          task = std::move(tasks.front());
+          tasks.pop_front();
+        }
+        --pending;
+        return true;
+      }
+    }
+
+    for (unsigned offset = 1; offset < size(); ++offset) {
+      Queue &victim = *queues[(home + offset) % size()];
+      std::lock_guard lock(victim.mutex);
+      auto &tasks = victim.tasks[level];
+      if (!tasks.empty()) {
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        --pending;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t begin, size_t end)> &body) {
+  if (count == 0) {
+    return;
+  }
+
+  struct Loop {
+    const std::function<void(size_t, size_t)> *body = nullptr;
+    size_t count = 0;
+    size_t chunkSize = 0;
+    std::atomic<size_t> nextChunk = 0;
+    std::atomic<size_t> remaining = 0;
+
+    void runChunks() {
+      const size_t chunks = (count + chunkSize - 1) / chunkSize;
+      for (size_t chunk; (chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+        const size_t begin = chunk * chunkSize;
+        (*body)(begin, std::min(count, begin + chunkSize));
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          remaining.notify_all();
+        }
+      }
+    }
+  };
+
+  const size_t chunks = std::min<size_t>(count, size_t(size()) * 8);
+  auto loop = std::make_shared<Loop>();
+  loop->body = &body;
+  loop->count = count;
+  loop->chunkSize = (count + chunks - 1) / chunks;
+  loop->remaining = (count + loop->chunkSize - 1) / loop->chunkSize;
+
+  for (size_t helper = 0, helpers = std::min<size_t>(loop->remaining, size()); helper < helpers; ++helper) {
+    submit([loop] { loop->runChunks(); });
+  }
+
+  loop->runChunks();
+  for (size_t left; (left = loop->remaining.load(std::memory_order_acquire)) != 0;) {
+    loop->remaining.wait(left, std::memory_order_acquire);
+  }
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+  currentPool = this;
+  currentWorker = index;
+
+  std::function<void()> task;
+  while (true) {
+    if (popTask(index, TaskPriority::Low, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock lock(sleepMutex);
+    wake.wait(lock, [this] { return stopping || pending != 0; });
+    if (stopping && pending == 0) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+enum class TaskPriority {
+  High,
+  Normal,
+  Low
+};
+
+class ThreadPool {
+  public:
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task, TaskPriority priority = TaskPriority::Normal);
+
+    template <typename Task>
+    auto async(TaskPriority priority, Task &&task) -> std::future<std::invoke_result_t<Task>> {
+      using Result = std::invoke_result_t<Task>;
+      auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+      std::future<Result> result = packaged->get_future();
+      submit([packaged] { (*packaged)(); }, priority);
+      return result;
+    }
+
+    void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)> &body);
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+  private:
+    static constexpr size_t PRIORITY_COUNT = 3;
+
+    struct Queue {
+      std::mutex mutex;
+      std::array<std::deque<std::function<void()>>, PRIORITY_COUNT> tasks;
+    };
+
+    bool popTask(unsigned home, TaskPriority lowest, std::function<void()> &task);
+    void workerLoop(unsigned index);
+  private:
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> pending = 0;
+    std::atomic<unsigned> nextQueue = 0;
+    bool stopping = false;
+};
+
+#endif //!THREAD_POOL_H
@@ -1,6 +1,9 @@
 #include "Sudoku.h"
 
-int main() {
+int main(int argc, char **argv) {
   Sudoku instance;
+  if (!instance.parseArguments(argc, argv)) {
+    return 1;
+  }
   return instance.run();
 }
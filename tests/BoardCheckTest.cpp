@@ -0,0 +1,88 @@
+#include "BatchSolver.h"
+#include "Generator.h"
+#include "Solver.h"
+#include "SolverEngine.h"
+#include "TestSupport.h"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+constexpr int GRID_COUNT = 2000;
+constexpr int DAMAGES_PER_GRID = 100;
+
+BoardCheck scanBoard(const NumberGrid &board) {
+  BoardCheck check;
+  for (int r = 0; r < BOARD_DIM; ++r) {
+    for (int c = 0; c < BOARD_DIM; ++c) {
+      const int value = board[r][c];
+      if (value == 0) {
+        check.full = false;
+        continue;
+      }
+      if (value > BOARD_DIM || isConflicting(board, r, c)) {
+        check.conflicts[check.conflictCount++] = static_cast<uint8_t>(r * BOARD_DIM + c);
+      }
+    }
+  }
+  check.valid = check.conflictCount == 0;
+  return check;
+}
+
+bool sameCheck(const BoardCheck &a, const BoardCheck &b) {
+  return a.full == b.full && a.valid == b.valid && a.conflictCount == b.conflictCount
+    && std::equal(a.conflicts.begin(), a.conflicts.begin() + a.conflictCount, b.conflicts.begin());
+}
+
+void checkDamagedGrids() {
+  std::default_random_engine rng(1);
+  std::uniform_int_distribution<int> cellDist(0, CELL_COUNT - 1);
+  std::uniform_int_distribution<int> damageDist(1, 4);
+  std::uniform_int_distribution<int> digitDist(0, BOARD_DIM);
+  std::uniform_int_distribution<int> byteDist(BOARD_DIM + 1, 255);
+
+  int mismatches = 0;
+  for (int grid = 0; grid < GRID_COUNT; ++grid) {
+    const NumberGrid solved = generateSolvedGrid(rng);
+    const BoardCheck clean = checkBoard(solved);
+    expect(clean.full && clean.valid && clean.conflictCount == 0, "a generated grid to pass the check");
+
+    for (int damage = 0; damage < DAMAGES_PER_GRID; ++damage) {
+      NumberGrid board = solved;
+      for (int changes = damageDist(rng); changes > 0; --changes) {
+        const int cell = cellDist(rng);
+        const int value = rng() % 16 == 0 ? byteDist(rng) : digitDist(rng);
+        board[cell / BOARD_DIM][cell % BOARD_DIM] = static_cast<uint8_t>(value);
+      }
+      mismatches += !sameCheck(checkBoard(board), scanBoard(board));
+    }
+  }
+  expect(mismatches == 0, "checkBoard to match the per-cell scan on every damaged grid");
+}
+
+void checkOutOfRangeRejected() {
+  for (SolverEngine *engine : solverEngines()) {
+    for (int value : { 10, 15, 31, 32, 200, 255 }) {
+      NumberGrid puzzle{};
+      puzzle[8][8] = static_cast<uint8_t>(value);
+
+      BatchOptions options;
+      options.solver.engine = engine;
+      expect(solveOne(puzzle, options).status == BatchStatus::Invalid, "solveOne to reject values above 9");
+
+      SolverStats stats;
+      NumberGrid board = puzzle;
+      expect(engine->count(puzzle, 2, {}, stats) == 0, "count to find no solution for values above 9");
+      expect(!engine->solve(board, {}, stats), "solve to fail for values above 9");
+    }
+  }
+}
+
+}
+
+int main() {
+  checkDamagedGrids();
+  checkOutOfRangeRejected();
+  return testResult();
+}
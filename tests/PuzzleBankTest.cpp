@@ -0,0 +1,103 @@
+#include "PuzzleBank.h"
+#include "Solver.h"
+#include "TestSupport.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+
+namespace {
+
+std::vector<PuzzleBankLevel> buildLevels(std::default_random_engine &rng) {
+  std::vector<PuzzleBankLevel> levels = { { 45, -1, {} }, { 25, -1, {} }, { 0, 1, {} } };
+  for (size_t level = 0; level < levels.size(); ++level) {
+    for (size_t i = 0; i < 12 + level; ++i) {
+      GeneratorOptions options;
+      options.targetClues = levels[level].targetClues > 0 ? levels[level].targetClues : 30;
+      options.grade = true;
+      const GeneratedPuzzle puzzle = generatePuzzle(options, rng);
+      levels[level].records.push_back(encodePuzzle(puzzle));
+
+      GeneratedPuzzle decoded;
+      expect(decodePuzzle(levels[level].records.back(), decoded), "a fresh record to decode");
+      expect(decoded.puzzle == puzzle.puzzle && decoded.solution == puzzle.solution, "the grids to round-trip");
+      expect(decoded.clues == puzzle.clues && decoded.guesses == puzzle.guesses, "clues and guesses to round-trip");
+      expect(decoded.grade.score == puzzle.grade.score && decoded.grade.hardest == puzzle.grade.hardest
+             && decoded.grade.solved == puzzle.grade.solved, "the grade to round-trip");
+    }
+  }
+  return levels;
+}
+
+void checkDrawOnce(PuzzleBank &bank, const std::vector<PuzzleBankLevel> &levels) {
+  for (const PuzzleBankLevel &level : levels) {
+    std::set<NumberGrid> seen;
+    GeneratedPuzzle puzzle;
+    while (bank.draw(level.targetClues, level.band, puzzle)) {
+      expect(seen.insert(puzzle.puzzle).second, "each record to be drawn once");
+      expect(isSolved(puzzle.solution), "a drawn solution to be solved");
+      expect(puzzle.attempts == 0, "a bank draw to report no generation attempts");
+    }
+    expect(seen.size() == level.records.size(), "every record of a level to be drawn");
+    expect(bank.remaining(level.targetClues, level.band) == 0, "a drained level to report nothing remaining");
+  }
+
+  GeneratedPuzzle puzzle;
+  expect(!bank.draw(35, -1, puzzle), "a missing level to draw nothing");
+}
+
+void writeCopy(const std::filesystem::path &path, std::string bytes, size_t offset, const void *value, size_t size) {
+  std::memcpy(bytes.data() + offset, value, size);
+  std::ofstream(path, std::ios::binary).write(bytes.data(), std::streamsize(bytes.size()));
+}
+
+void checkCorruptBanks(const std::filesystem::path &dir, const std::filesystem::path &bankPath,
+                       const std::vector<PuzzleBankLevel> &levels) {
+  PuzzleBank bank;
+  expect(!bank.open((dir / "missing.bank").string()), "a missing file to be rejected");
+
+  std::ofstream(dir / "junk.bank", std::ios::binary) << "junk";
+  expect(!bank.open((dir / "junk.bank").string()), "a short file to be rejected");
+
+  std::ifstream in(bankPath, std::ios::binary);
+  const std::string bytes((std::istreambuf_iterator<char>(in)), {});
+  const uint64_t wrappingCount = ~uint64_t(0) - 11;
+  writeCopy(dir / "wrap.bank", bytes, sizeof(BankHeader) + sizeof(BankLevel) + offsetof(BankLevel, recordCount),
+            &wrappingCount, sizeof(wrappingCount));
+  expect(!bank.open((dir / "wrap.bank").string()), "a record count that wraps the total to be rejected");
+
+  GeneratedPuzzle puzzle;
+  std::vector<PuzzleBankLevel> single = { { 45, -1, { levels[0].records[0] } } };
+  single[0].records[0].solution[3] = 0xAF;
+  expect(writePuzzleBank((dir / "digit.bank").string(), single), "the bad-digit bank to be written");
+  expect(bank.open((dir / "digit.bank").string()) && !bank.draw(45, -1, puzzle), "a bad digit to be skipped");
+
+  single[0].records[0] = levels[0].records[0];
+  single[0].records[0].hardest = TECHNIQUE_COUNT;
+  expect(writePuzzleBank((dir / "technique.bank").string(), single), "the bad-technique bank to be written");
+  expect(bank.open((dir / "technique.bank").string()) && !bank.draw(45, -1, puzzle), "a bad technique to be skipped");
+}
+
+}
+
+int main() {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path() / "sudoku-bank-test";
+  std::filesystem::create_directories(dir);
+  const std::filesystem::path bankPath = dir / "levels.bank";
+
+  std::default_random_engine rng(5);
+  const std::vector<PuzzleBankLevel> levels = buildLevels(rng);
+  if (expect(writePuzzleBank(bankPath.string(), levels), "the bank to be written")) {
+    PuzzleBank bank;
+    if (expect(bank.open(bankPath.string()), "the bank to open")) {
+      checkDrawOnce(bank, levels);
+    }
+    checkCorruptBanks(dir, bankPath, levels);
+  }
+
+  std::filesystem::remove_all(dir);
+  return testResult();
+}
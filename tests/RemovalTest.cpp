@@ -0,0 +1,53 @@
+#include "Generator.h"
+#include "SolverEngine.h"
+#include "TestSupport.h"
+#include "ThreadPool.h"
+
+namespace {
+
+constexpr int SEEDS = 10;
+
+bool sameAsSerial(GeneratorOptions options, RemovalStrategy removal, ThreadPool &pool, unsigned seed) {
+  std::default_random_engine serialRng(seed);
+  std::default_random_engine parallelRng(seed);
+  const GeneratedPuzzle serial = buildPuzzle(options, serialRng);
+
+  options.pool = &pool;
+  options.removal = removal;
+  const GeneratedPuzzle parallel = buildPuzzle(options, parallelRng);
+  return parallel.puzzle == serial.puzzle && parallel.solution == serial.solution && parallel.clues == serial.clues;
+}
+
+void checkSpeculative(ThreadPool &pool) {
+  for (int target : { 45, 35, 25, 17 }) {
+    for (unsigned seed = 0; seed < SEEDS; ++seed) {
+      GeneratorOptions options;
+      options.targetClues = target;
+      expect(sameAsSerial(options, RemovalStrategy::Speculative, pool, seed),
+             "speculative removal to produce the serial puzzle");
+    }
+  }
+}
+
+void checkSplitTree(ThreadPool &pool) {
+  for (SolverEngine *engine : solverEngines()) {
+    for (int target : { 35, 25 }) {
+      for (unsigned seed = 0; seed < SEEDS / 2; ++seed) {
+        GeneratorOptions options;
+        options.targetClues = target;
+        options.solver.engine = engine;
+        expect(sameAsSerial(options, RemovalStrategy::SplitTree, pool, seed),
+               "split-tree removal to produce the serial puzzle");
+      }
+    }
+  }
+}
+
+}
+
+int main() {
+  ThreadPool pool(4);
+  checkSpeculative(pool);
+  checkSplitTree(pool);
+  return testResult();
+}
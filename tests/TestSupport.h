@@ -0,0 +1,25 @@
+#pragma once
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <iostream>
+#include <source_location>
+
+inline int &failureCount() {
+  static int failures = 0;
+  return failures;
+}
+
+inline bool expect(bool condition, const char *what, std::source_location where = std::source_location::current()) {
+  if (!condition) {
+    ++failureCount();
+    std::cerr << where.file_name() << ':' << where.line() << ": expected " << what << '\n';
+  }
+  return condition;
+}
+
+inline int testResult() {
+  return failureCount() == 0 ? 0 : 1;
+}
+
+#endif //!TEST_SUPPORT_H
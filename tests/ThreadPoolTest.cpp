@@ -0,0 +1,55 @@
+#include "TestSupport.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace {
+
+constexpr int ROUNDS = 50;
+constexpr size_t OUTER = 100;
+constexpr size_t INNER = 10;
+constexpr long NESTED_SUM = long(OUTER * INNER) * long(OUTER * INNER - 1) / 2;
+
+long nestedSum(ThreadPool &pool) {
+  std::atomic<long> sum = 0;
+  pool.parallelFor(OUTER, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      pool.parallelFor(INNER, [&](size_t innerBegin, size_t innerEnd) {
+        for (size_t j = innerBegin; j < innerEnd; ++j) {
+          sum += long(i * INNER + j);
+        }
+      });
+    }
+  });
+  return sum;
+}
+
+void checkNestedParallelFor(unsigned threads) {
+  ThreadPool pool(threads);
+  expect(pool.size() == threads, "the pool to start the requested worker count");
+
+  for (int round = 0; round < ROUNDS; ++round) {
+    expect(nestedSum(pool) == NESTED_SUM, "nested parallelFor from the caller to visit every index once");
+  }
+
+  std::vector<std::future<long>> sums;
+  for (TaskPriority priority : { TaskPriority::High, TaskPriority::Normal, TaskPriority::Low }) {
+    for (unsigned task = 0; task < threads; ++task) {
+      sums.push_back(pool.async(priority, [&pool] { return nestedSum(pool); }));
+    }
+  }
+  for (std::future<long> &sum : sums) {
+    expect(sum.get() == NESTED_SUM, "nested parallelFor from a worker to visit every index once");
+  }
+}
+
+}
+
+int main() {
+  for (unsigned threads : { 1u, 2u, 4u }) {
+    checkNestedParallelFor(threads);
+  }
+  return testResult();
+}
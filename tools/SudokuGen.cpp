@@ -0,0 +1,211 @@
+#include "Generator.h"
+#include "PuzzleBank.h"
+#include "ThreadPool.h"
+#include "ToolSupport.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+  struct Level {
+    std::string name;
+    int targetClues = 0;
+    int band = -1;
+  };
+
+  struct Settings {
+    size_t count = 100;
+    std::vector<Level> levels;
+    bool bank = false;
+    std::string output;
+    unsigned threads = 0;
+    uint64_t seed = std::random_device{}();
+  };
+
+  void printUsage() {
+    std::cerr << "Usage: sudoku-gen [options]\n"
+              << "  --count=<n>         Puzzles per difficulty (default 100)\n"
+              << "  --levels=<list>     Comma-separated clue targets and/or band names\n"
+              << "                      (gentle, moderate, tough, fiendish); default 45,35,25\n"
+              << "  --format=text|bank  81-char lines or the binary puzzle bank (default text)\n"
+              << "  --output=<path>     Output file (default stdout, required for bank)\n"
+              << "  --threads=<n>       Worker threads (default: all hardware threads)\n"
+              << "  --seed=<n>          Seed for reproducible output\n";
+  }
+
+  bool parseLevel(std::string_view token, Level &level) {
+    level = { std::string(token) };
+    for (size_t band = 0; band < HARDNESS_BANDS.size(); ++band) {
+      const std::string_view name = HARDNESS_BANDS[band].name;
+      if (std::equal(token.begin(), token.end(), name.begin(), name.end(),
+                     [](char a, char b) { return std::tolower(a) == std::tolower(b); })) {
+        level.band = static_cast<int>(band);
+        level.targetClues = HARDNESS_BANDS[band].targetClues;
+        return true;
+      }
+    }
+    return parseNumber(token, level.targetClues) && level.targetClues >= 17 && level.targetClues <= CELL_COUNT;
+  }
+
+  bool parseArguments(int argc, char **argv, Settings &settings) {
+    std::string_view levels = "45,35,25";
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg = argv[i];
+      const std::string_view value = arg.substr(arg.find('=') + 1);
+      bool valid = true;
+      if (arg.starts_with("--count=")) {
+        valid = parseNumber(value, settings.count);
+      } else if (arg.starts_with("--levels=")) {
+        levels = value;
+      } else if (arg.starts_with("--format=")) {
+        valid = value == "text" || value == "bank";
+        settings.bank = value == "bank";
+      } else if (arg.starts_with("--output=")) {
+        settings.output = value;
+      } else if (arg.starts_with("--threads=")) {
+        valid = parseNumber(value, settings.threads);
+      } else if (arg.starts_with("--seed=")) {
+        valid = parseNumber(value, settings.seed);
+      } else {
+        printUsage();
+        return false;
+      }
+
+      if (!valid) {
+        std::cerr << "Invalid value: " << arg << std::endl;
+        return false;
+      }
+    }
+
+    while (!levels.empty()) {
+      const size_t comma = std::min(levels.find(','), levels.size());
+      Level level;
+      if (!parseLevel(levels.substr(0, comma), level)) {
+        std::cerr << "Unknown level: " << levels.substr(0, comma) << std::endl;
+        return false;
+      }
+      settings.levels.push_back(level);
+      levels.remove_prefix(std::min(levels.size(), comma + 1));
+    }
+
+    if (settings.bank && settings.output.empty()) {
+      std::cerr << "--format=bank needs --output=<path>" << std::endl;
+      return false;
+    }
+    return !settings.levels.empty();
+  }
+
+  void writeLine(std::ostream &out, const NumberGrid &puzzle) {
+    std::array<char, CELL_COUNT + 1> line;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+      const int value = puzzle[cell / BOARD_DIM][cell % BOARD_DIM];
+      line[cell] = value ? static_cast<char>('0' + value) : '.';
+    }
+    line[CELL_COUNT] = '\n';
+    out.write(line.data(), line.size());
+  }
+
+  double percentile(const std::vector<double> &sorted, double fraction) {
+    if (sorted.empty()) {
+      return 0.0;
+    }
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()))];
+  }
+}
+
+int main(int argc, char **argv) {
+  Settings settings;
+  if (!parseArguments(argc, argv, settings)) {
+    return 1;
+  }
+
+  std::ofstream file;
+  if (!settings.output.empty() && !settings.bank) {
+    file.open(settings.output, std::ios::binary);
+    if (!file.is_open()) {
+      std::cerr << "Cannot open " << settings.output << std::endl;
+      return 1;
+    }
+  }
+  std::ostream &out = file.is_open() ? file : std::cout;
+
+  ThreadPool pool(settings.threads);
+  std::mutex outputMutex;
+  std::vector<PuzzleBankLevel> bankLevels;
+
+  std::cerr << "generating " << settings.count << " puzzles x " << settings.levels.size()
+            << " levels on " << pool.size() << " threads" << std::endl;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t index = 0; index < settings.levels.size(); ++index) {
+    const Level &level = settings.levels[index];
+    GeneratorOptions options;
+    options.targetClues = level.targetClues;
+    options.band = level.band;
+    options.grade = settings.bank;
+    const bool minimal = level.band < 0 && level.targetClues < MINIMAL_CLUE_LIMIT;
+    options.removal = minimal ? RemovalStrategy::Minimal : RemovalStrategy::Serial;
+
+    std::vector<PuzzleRecord> records(settings.bank ? settings.count : 0);
+    std::vector<double> latencies(settings.count);
+    std::vector<int> clues(settings.count);
+
+    const auto levelStart = std::chrono::steady_clock::now();
+    pool.parallelFor(settings.count, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        std::default_random_engine rng(static_cast<unsigned>(settings.seed + index * settings.count + i));
+        const auto puzzleStart = std::chrono::steady_clock::now();
+        GeneratedPuzzle puzzle = generatePuzzle(options, rng);
+        while (puzzle.missedTarget) {
+          puzzle = generatePuzzle(options, rng);
+        }
+        latencies[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - puzzleStart).count();
+        clues[i] = puzzle.clues;
+
+        if (settings.bank) {
+          records[i] = encodePuzzle(puzzle);
+        } else {
+          std::lock_guard lock(outputMutex);
+          writeLine(out, puzzle.puzzle);
+        }
+      }
+    });
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - levelStart;
+
+    std::sort(latencies.begin(), latencies.end());
+    double averageClues = 0.0;
+    for (int count : clues) {
+      averageClues += count;
+    }
+    averageClues /= std::max<size_t>(1, settings.count);
+
+    std::cerr << level.name << ": " << settings.count << " puzzles in " << elapsed.count() << " s, "
+              << perSecond(settings.count, elapsed) << " puzzles/sec, "
+              << averageClues << " clues avg, latency ms p50 " << percentile(latencies, 0.5)
+              << " p90 " << percentile(latencies, 0.9) << " p99 " << percentile(latencies, 0.99)
+              << " max " << percentile(latencies, 1.0) << std::endl;
+
+    if (settings.bank) {
+      bankLevels.push_back({ level.targetClues, level.band, std::move(records) });
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  out.flush();
+  if (settings.bank && !writePuzzleBank(settings.output, bankLevels)) {
+    std::cerr << "Cannot write " << settings.output << std::endl;
+    return 1;
+  }
+
+  const size_t total = settings.count * settings.levels.size();
+  std::cerr << "total: " << total << " puzzles in " << elapsed.count() << " s, "
+            << perSecond(total, elapsed) << " puzzles/sec" << std::endl;
+  return out.good() ? 0 : 1;
+}
@@ -0,0 +1,310 @@
+#include "BatchSolver.h"
+#include "SolverEngine.h"
+#include "ThreadPool.h"
+#include "ToolSupport.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  constexpr size_t CHUNK_SIZE = 4096;
+  constexpr size_t READ_CHUNK = size_t(4) << 20;
+
+  struct Settings {
+    unsigned threads = 0;
+    std::string output;
+    std::vector<std::string> inputs;
+    BatchOptions batch{};
+  };
+
+  struct Chunk {
+    std::vector<NumberGrid> puzzles;
+    std::vector<bool> valid;
+  };
+
+  struct Totals {
+    uint64_t puzzles = 0;
+    uint64_t solved = 0;
+    uint64_t unsolvable = 0;
+    uint64_t invalid = 0;
+  };
+
+  struct ChunkOutput {
+    std::string text;
+    Totals totals;
+  };
+
+  void printUsage() {
+    std::cerr << "Usage: sudoku-solve [options] [file...]\n"
+              << "  Reads 81-char puzzles (digits, '0' or '.' for empty) from the files or stdin.\n"
+              << "  --count[=<limit>]  Print the number of solutions, capped at limit (default 2)\n"
+              << "  --engine=<name>    Solver engine\n"
+              << "  --output=<path>    Output file (default stdout)\n"
+              << "  --threads=<n>      Worker threads (default: all hardware threads)\n";
+  }
+
+  bool parseArguments(int argc, char **argv, Settings &settings) {
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg = argv[i];
+      const std::string_view value = arg.substr(arg.find('=') + 1);
+      bool valid = true;
+      if (arg == "--count") {
+        settings.batch.mode = BatchMode::Count;
+      } else if (arg.starts_with("--count=")) {
+        settings.batch.mode = BatchMode::Count;
+        valid = parseNumber(value, settings.batch.countLimit) && settings.batch.countLimit > 0;
+      } else if (arg.starts_with("--engine=")) {
+        settings.batch.solver.engine = findSolverEngine(value);
+        valid = settings.batch.solver.engine != nullptr;
+      } else if (arg.starts_with("--output=")) {
+        settings.output = value;
+      } else if (arg.starts_with("--threads=")) {
+        valid = parseNumber(value, settings.threads);
+      } else if (arg == "-" || !arg.starts_with("-")) {
+        settings.inputs.emplace_back(arg);
+      } else {
+        printUsage();
+        return false;
+      }
+
+      if (!valid) {
+        std::cerr << "Invalid value: " << arg << std::endl;
+        return false;
+      }
+    }
+
+    if (settings.inputs.empty()) {
+      settings.inputs.emplace_back("-");
+    }
+    return true;
+  }
+
+  bool parsePuzzle(std::string_view line, NumberGrid &puzzle) {
+    if (line.size() < CELL_COUNT || (line.size() > CELL_COUNT && std::isdigit(static_cast<unsigned char>(line[CELL_COUNT])))) {
+      return false;
+    }
+
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+      const char ch = line[cell];
+      if (ch == '.' || ch == '0') {
+        puzzle[cell / BOARD_DIM][cell % BOARD_DIM] = 0;
+      } else if (ch >= '1' && ch <= '9') {
+        puzzle[cell / BOARD_DIM][cell % BOARD_DIM] = static_cast<uint8_t>(ch - '0');
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool forEachChunk(FILE *stream, const std::function<void(std::string_view)> &onLine) {
+    std::vector<char> buffer(READ_CHUNK);
+    size_t carry = 0;
+    while (true) {
+      if (carry == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+      }
+
+      const size_t read = std::fread(buffer.data() + carry, 1, buffer.size() - carry, stream);
+      const size_t filled = carry + read;
+      size_t begin = 0;
+      for (size_t end = 0; end < filled; ++end) {
+        if (buffer[end] == '\n') {
+          onLine(std::string_view(buffer.data() + begin, end - begin));
+          begin = end + 1;
+        }
+      }
+
+      carry = filled - begin;
+      std::copy(buffer.begin() + begin, buffer.begin() + filled, buffer.begin());
+      if (read == 0) {
+        if (carry > 0) {
+          onLine(std::string_view(buffer.data(), carry));
+        }
+        return !std::ferror(stream);
+      }
+    }
+  }
+
+  bool forEachLine(const std::string &path, const std::function<void(std::string_view)> &onLine) {
+    if (path == "-") {
+      return forEachChunk(stdin, onLine);
+    }
+
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+      const size_t size = static_cast<size_t>(info.st_size);
+      void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if (view == MAP_FAILED) {
+        return false;
+      }
+
+      madvise(view, size, MADV_SEQUENTIAL);
+      std::string_view text(static_cast<const char *>(view), size);
+      while (!text.empty()) {
+        const size_t end = std::min(text.find('\n'), text.size());
+        onLine(text.substr(0, end));
+        text.remove_prefix(std::min(text.size(), end + 1));
+      }
+      munmap(view, size);
+      return true;
+    }
+
+    if (fd >= 0) {
+      ::close(fd);
+    }
+#endif
+
+    FILE *stream = std::fopen(path.c_str(), "rb");
+    if (!stream) {
+      return false;
+    }
+
+    const bool ok = forEachChunk(stream, onLine);
+    std::fclose(stream);
+    return ok;
+  }
+
+  ChunkOutput solveChunk(const Chunk &chunk, const BatchOptions &options) {
+    ChunkOutput output;
+    output.text.reserve(chunk.puzzles.size() * (CELL_COUNT + 1));
+    output.totals.puzzles = chunk.puzzles.size();
+
+    for (size_t i = 0; i < chunk.puzzles.size(); ++i) {
+      const BatchResult result = chunk.valid[i] ? solveOne(chunk.puzzles[i], options) : BatchResult{};
+      if (result.status == BatchStatus::Invalid) {
+        ++output.totals.invalid;
+        output.text += "invalid\n";
+        continue;
+      }
+
+      ++(result.solutions > 0 ? output.totals.solved : output.totals.unsolvable);
+      if (options.mode == BatchMode::Count) {
+        std::array<char, 16> digits;
+        const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), result.solutions).ptr;
+        output.text.append(digits.data(), end);
+      } else if (result.status == BatchStatus::Solved) {
+        for (const auto &row : result.solution) {
+          for (uint8_t value : row) {
+            output.text += static_cast<char>('0' + value);
+          }
+        }
+      } else {
+        output.text += "unsolvable";
+      }
+      output.text += '\n';
+    }
+    return output;
+  }
+}
+
+int main(int argc, char **argv) {
+  Settings settings;
+  if (!parseArguments(argc, argv, settings)) {
+    return 1;
+  }
+
+  FILE *out = settings.output.empty() ? stdout : std::fopen(settings.output.c_str(), "wb");
+  if (!out) {
+    std::cerr << "Cannot open " << settings.output << std::endl;
+    return 1;
+  }
+
+  ThreadPool pool(settings.threads);
+  const size_t window = size_t(pool.size()) * 4;
+  std::deque<std::future<ChunkOutput>> inFlight;
+  Totals totals;
+
+  auto drainOne = [&] {
+    const ChunkOutput result = inFlight.front().get();
+    inFlight.pop_front();
+    std::fwrite(result.text.data(), 1, result.text.size(), out);
+    totals.puzzles += result.totals.puzzles;
+    totals.solved += result.totals.solved;
+    totals.unsolvable += result.totals.unsolvable;
+    totals.invalid += result.totals.invalid;
+  };
+
+  Chunk chunk;
+  auto flushChunk = [&] {
+    if (chunk.puzzles.empty()) {
+      return;
+    }
+
+    if (inFlight.size() >= window) {
+      drainOne();
+    }
+    inFlight.push_back(pool.async(TaskPriority::High, [&settings, work = std::move(chunk)] {
+      return solveChunk(work, settings.batch);
+    }));
+    chunk = {};
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  bool ok = true;
+  for (const std::string &input : settings.inputs) {
+    const bool read = forEachLine(input, [&](std::string_view line) {
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      if (line.empty() || line.front() == '#') {
+        return;
+      }
+
+      if (chunk.puzzles.empty()) {
+        chunk.puzzles.reserve(CHUNK_SIZE);
+        chunk.valid.reserve(CHUNK_SIZE);
+      }
+      chunk.puzzles.emplace_back();
+      chunk.valid.push_back(parsePuzzle(line, chunk.puzzles.back()));
+      if (chunk.puzzles.size() == CHUNK_SIZE) {
+        flushChunk();
+      }
+    });
+
+    if (!read) {
+      std::cerr << "Cannot read " << input << std::endl;
+      ok = false;
+    }
+  }
+
+  flushChunk();
+  while (!inFlight.empty()) {
+    drainOne();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  ok = std::fflush(out) == 0 && ok;
+  if (out != stdout) {
+    ok = std::fclose(out) == 0 && ok;
+  }
+
+  std::cerr << "puzzles:      " << totals.puzzles << '\n'
+            << (settings.batch.mode == BatchMode::Count ? "with any:     " : "solved:       ") << totals.solved << '\n'
+            << "unsolvable:   " << totals.unsolvable << '\n'
+            << "invalid:      " << totals.invalid << '\n'
+            << "seconds:      " << elapsed.count() << '\n'
+            << "puzzles/sec:  " << perSecond(totals.puzzles, elapsed) << std::endl;
+  return ok ? 0 : 1;
+}
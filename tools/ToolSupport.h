@@ -0,0 +1,20 @@
+#pragma once
+#ifndef TOOL_SUPPORT_H
+#define TOOL_SUPPORT_H
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+template <typename T>
+bool parseNumber(std::string_view text, T &value) {
+  const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == std::errc() && end == text.data() + text.size();
+}
+
+inline double perSecond(uint64_t count, std::chrono::duration<double> elapsed) {
+  return count > 0 && elapsed.count() > 0.0 ? count / elapsed.count() : 0.0;
+}
+
+#endif //!TOOL_SUPPORT_H